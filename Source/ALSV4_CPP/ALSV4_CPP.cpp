@@ -7,5 +7,14 @@
 
 #include "ALSV4_CPP.h"
 #include "Modules/ModuleManager.h"
+#include "Library/ALSLog.h"
+#include "Library/ALSStats.h"
 
 IMPLEMENT_MODULE(FDefaultGameModuleImpl, ALSV4_CPP);
+
+DEFINE_LOG_CATEGORY(LogALS);
+
+DEFINE_STAT(STAT_ALS_Traces);
+DEFINE_STAT(STAT_ALS_RPCs);
+
+CSV_DEFINE_CATEGORY_MODULE(ALSV4_CPP_API, ALS, true);
@@ -0,0 +1,305 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Benchmark/ALSBenchmarkCommandlet.h"
+
+#include "AI/NavigationSystemBase.h"
+#include "Character/AI/ALSAIController.h"
+#include "Character/ALSBaseCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Library/ALSLocomotionSimulation.h"
+#include "Library/ALSLog.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	const TCHAR* DefaultMapName = TEXT("/ALSV4_CPP/AdvancedLocomotionV4/Levels/ALS_GridLevel");
+
+	const TCHAR* DefaultCharacterClass =
+		TEXT("/ALSV4_CPP/AdvancedLocomotionV4/Blueprints/CharacterLogic/ALS_CharacterBP.ALS_CharacterBP_C");
+
+	/** Distance between spawned characters */
+	constexpr float SpawnSpacing = 200.0f;
+}
+
+UALSBenchmarkCommandlet::UALSBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UALSBenchmarkCommandlet::Main(const FString& Params)
+{
+	// Step 1: Parse the parameters
+	FString CharacterCountsParam = TEXT("100,500,1000");
+	FParse::Value(*Params, TEXT("Characters="), CharacterCountsParam);
+
+	int32 NumFrames = 600;
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+
+	int32 NumWarmupFrames = 60;
+	FParse::Value(*Params, TEXT("WarmupFrames="), NumWarmupFrames);
+
+	float DeltaTime = 1.0f / 30.0f;
+	FParse::Value(*Params, TEXT("DeltaTime="), DeltaTime);
+
+	FString MapName = DefaultMapName;
+	FParse::Value(*Params, TEXT("Map="), MapName);
+
+	FString CharacterClassName = DefaultCharacterClass;
+	FParse::Value(*Params, TEXT("CharacterClass="), CharacterClassName);
+
+	FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ALSBenchmark"),
+	                                     FString::Printf(TEXT("ALSBenchmark-%s.csv"),
+	                                                     *FDateTime::Now().ToString()));
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	UClass* CharacterClass = LoadClass<AALSBaseCharacter>(nullptr, *CharacterClassName);
+	if (!CharacterClass)
+	{
+		UE_LOG(LogALS, Error, TEXT("Benchmark character class %s could not be loaded"), *CharacterClassName);
+		return 1;
+	}
+
+	// Nothing is rendered, which would switch foot IK off for every character, the budget governor would lower the
+	// quality of the characters being measured and without view points every character would share its animation.
+	// These are only kept if asked for, and restored when the benchmark is done.
+	TArray<TPair<IConsoleVariable*, int32>> DisabledFeatures;
+	ON_SCOPE_EXIT
+	{
+		for (const TPair<IConsoleVariable*, int32>& Feature : DisabledFeatures)
+		{
+			Feature.Key->Set(Feature.Value, ECVF_SetByCode);
+		}
+	};
+
+	static const TCHAR* AdaptiveFeatures[][2] = {
+		{TEXT("FootIKLOD"), TEXT("ALS.FootIK.LOD")},
+		{TEXT("Budget"), TEXT("ALS.Budget")},
+		{TEXT("AnimSharing"), TEXT("ALS.AnimSharing")},
+	};
+	for (const auto& Feature : AdaptiveFeatures)
+	{
+		IConsoleVariable* FeatureCVar = IConsoleManager::Get().FindConsoleVariable(Feature[1]);
+		if (FeatureCVar && !FParse::Param(*Params, Feature[0]))
+		{
+			DisabledFeatures.Emplace(FeatureCVar, FeatureCVar->GetInt());
+			FeatureCVar->Set(0, ECVF_SetByCode);
+		}
+	}
+
+	TArray<FString> CharacterCounts;
+	CharacterCountsParam.ParseIntoArray(CharacterCounts, TEXT(","));
+
+	// Step 2: Run the benchmark for each character count
+	FString Csv = TEXT("Characters,Spawned,Frames,FrameMs");
+	for (uint8 Phase = 0; Phase < static_cast<uint8>(EALSBenchmarkPhase::MAX); ++Phase)
+	{
+		const TCHAR* PhaseName = FALSBenchmarkTimers::GetPhaseName(static_cast<EALSBenchmarkPhase>(Phase));
+		Csv += FString::Printf(TEXT(",%sMs"), PhaseName);
+	}
+	Csv += TEXT(",MemoryPerCharacterKB,SimulationMs\n");
+
+	for (const FString& CharacterCount : CharacterCounts)
+	{
+		const int32 NumCharacters = FCString::Atoi(*CharacterCount);
+		if (NumCharacters <= 0)
+		{
+			continue;
+		}
+
+		FBenchmarkResult Result;
+		if (!RunBenchmark(MapName, CharacterClass, NumCharacters, NumFrames, NumWarmupFrames, DeltaTime, Result))
+		{
+			return 1;
+		}
+		Result.SimulationMs = RunSimulation(NumCharacters, NumFrames, DeltaTime);
+
+		Csv += FString::Printf(TEXT("%d,%d,%d,%.4f"), Result.NumCharacters, Result.NumSpawned, NumFrames,
+		                       Result.FrameMs);
+		for (const double PhaseMs : Result.PhaseMs)
+		{
+			Csv += FString::Printf(TEXT(",%.4f"), PhaseMs);
+		}
+		Csv += FString::Printf(TEXT(",%.2f,%.4f\n"), Result.MemoryPerCharacterKB, Result.SimulationMs);
+	}
+
+	// Step 3: Write the results
+	UE_LOG(LogALS, Display, TEXT("ALS benchmark results:\n%s"), *Csv);
+	if (!FFileHelper::SaveStringToFile(Csv, *OutputPath))
+	{
+		UE_LOG(LogALS, Error, TEXT("Benchmark results could not be written to %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogALS, Display, TEXT("Benchmark results written to %s"), *OutputPath);
+	return 0;
+}
+
+UWorld* UALSBenchmarkCommandlet::LoadWorld(const FString& MapName) const
+{
+	UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogALS, Error, TEXT("Benchmark map %s could not be loaded"), *MapName);
+		return nullptr;
+	}
+
+	// Same setup as a standalone game, without a viewport or local player
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->InitializeStandalone();
+
+	FWorldContext* WorldContext = GameInstance->GetWorldContext();
+	check(WorldContext);
+
+	World->AddToRoot();
+	World->WorldType = EWorldType::Game;
+	World->SetGameInstance(GameInstance);
+	WorldContext->SetCurrentWorld(World);
+
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld();
+	}
+
+	const FURL URL;
+	World->SetGameMode(URL);
+	FNavigationSystem::AddNavigationSystemToWorld(*World, FNavigationSystemRunMode::GameMode);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	return World;
+}
+
+void UALSBenchmarkCommandlet::UnloadWorld(UWorld* World)
+{
+	UGameInstance* GameInstance = World->GetGameInstance();
+
+	for (FActorIterator It(World); It; ++It)
+	{
+		It->RouteEndPlay(EEndPlayReason::Quit);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+
+	if (GameInstance)
+	{
+		GameInstance->Shutdown();
+	}
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+bool UALSBenchmarkCommandlet::RunBenchmark(const FString& MapName, UClass* CharacterClass, int32 NumCharacters,
+                                           int32 NumFrames, int32 NumWarmupFrames, float DeltaTime,
+                                           FBenchmarkResult& OutResult) const
+{
+	UWorld* World = LoadWorld(MapName);
+	if (!World)
+	{
+		return false;
+	}
+
+	// Step 1: Spawn the characters on a grid around the origin, each possessed by an ALS AI controller
+	const uint64 UsedMemoryBeforeSpawn = FPlatformMemory::GetStats().UsedPhysical;
+
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumCharacters)));
+	const float GridOffset = (GridSize - 1) * SpawnSpacing * 0.5f;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	int32 NumSpawned = 0;
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		const FVector Location((Index % GridSize) * SpawnSpacing - GridOffset,
+		                       (Index / GridSize) * SpawnSpacing - GridOffset, 200.0f);
+		AALSBaseCharacter* Character = World->SpawnActor<AALSBaseCharacter>(
+			CharacterClass, Location, FRotator::ZeroRotator, SpawnParams);
+		if (!Character)
+		{
+			continue;
+		}
+
+		// Nothing is rendered, animate the characters anyway so the anim update is measured
+		Character->GetMesh()->VisibilityBasedAnimTickOption =
+			EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+		Character->AIControllerClass = AALSAIController::StaticClass();
+		Character->SpawnDefaultController();
+		++NumSpawned;
+	}
+
+	const uint64 UsedMemoryAfterSpawn = FPlatformMemory::GetStats().UsedPhysical;
+
+	// Step 2: Let the characters settle, then measure
+	for (int32 Frame = 0; Frame < NumWarmupFrames; ++Frame)
+	{
+		World->Tick(LEVELTICK_All, DeltaTime);
+	}
+
+	FALSBenchmarkTimers::Reset();
+	FALSBenchmarkTimers::SetEnabled(true);
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		World->Tick(LEVELTICK_All, DeltaTime);
+	}
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	FALSBenchmarkTimers::SetEnabled(false);
+
+	// Step 3: Average the results per frame
+	const int32 NumMeasuredFrames = FMath::Max(1, NumFrames);
+	OutResult.NumCharacters = NumCharacters;
+	OutResult.NumSpawned = NumSpawned;
+	OutResult.FrameMs = ElapsedTime * 1000.0 / NumMeasuredFrames;
+	for (uint8 Phase = 0; Phase < static_cast<uint8>(EALSBenchmarkPhase::MAX); ++Phase)
+	{
+		OutResult.PhaseMs[Phase] =
+			FALSBenchmarkTimers::GetSeconds(static_cast<EALSBenchmarkPhase>(Phase)) * 1000.0 / NumMeasuredFrames;
+	}
+	OutResult.MemoryPerCharacterKB = NumSpawned > 0 && UsedMemoryAfterSpawn > UsedMemoryBeforeSpawn
+		                                 ? (UsedMemoryAfterSpawn - UsedMemoryBeforeSpawn) / 1024.0 / NumSpawned
+		                                 : 0.0;
+
+	UE_LOG(LogALS, Display, TEXT("Benchmarked %d characters (%d spawned): %.3f ms per frame"), NumCharacters,
+	       NumSpawned, OutResult.FrameMs);
+
+	UnloadWorld(World);
+	return true;
+}
+
+double UALSBenchmarkCommandlet::RunSimulation(int32 NumCharacters, int32 NumFrames, float DeltaTime)
+{
+	FALSLocomotionSimulation Simulation(FALSLocomotionSimulationSettings(), NumCharacters);
+	Simulation.AddCharacters(NumCharacters);
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Simulation.Step(DeltaTime);
+	}
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	return ElapsedTime * 1000.0 / FMath::Max(1, NumFrames);
+}
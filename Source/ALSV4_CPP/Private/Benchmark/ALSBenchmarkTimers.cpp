@@ -0,0 +1,40 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Benchmark/ALSBenchmarkTimers.h"
+
+bool FALSBenchmarkTimers::bEnabled = false;
+
+std::atomic<uint64> FALSBenchmarkTimers::Cycles[static_cast<uint8>(EALSBenchmarkPhase::MAX)];
+
+void FALSBenchmarkTimers::Reset()
+{
+	for (std::atomic<uint64>& PhaseCycles : Cycles)
+	{
+		PhaseCycles.store(0, std::memory_order_relaxed);
+	}
+}
+
+double FALSBenchmarkTimers::GetSeconds(EALSBenchmarkPhase Phase)
+{
+	return FPlatformTime::ToSeconds64(Cycles[static_cast<uint8>(Phase)].load(std::memory_order_relaxed));
+}
+
+const TCHAR* FALSBenchmarkTimers::GetPhaseName(EALSBenchmarkPhase Phase)
+{
+	static const TCHAR* PhaseNames[] = {
+		TEXT("CharacterTick"),
+		TEXT("AnimUpdate"),
+		TEXT("Camera"),
+		TEXT("Traces"),
+	};
+	static_assert(UE_ARRAY_COUNT(PhaseNames) == static_cast<uint8>(EALSBenchmarkPhase::MAX),
+	              "Every benchmark phase needs a name");
+
+	return PhaseNames[static_cast<uint8>(Phase)];
+}
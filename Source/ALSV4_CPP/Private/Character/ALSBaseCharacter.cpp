@@ -10,6 +10,9 @@
 
 
 #include "Character/ALSPlayerController.h"
+#include "Library/ALSStats.h"
+#include "Library/ALSTrace.h"
+#include "Character/ALSCharacterUpdateSubsystem.h"
 #include "Character/Animation/ALSCharacterAnimInstance.h"
 #include "Library/ALSMathLibrary.h"
 #include "Components/CapsuleComponent.h"
@@ -20,17 +23,23 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/GameplayStatics.h"
-#include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
 
+DECLARE_CYCLE_STAT(TEXT("Update Grounded Rotation"), STAT_ALS_UpdateGroundedRotation, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Mantle Check"), STAT_ALS_MantleCheck, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Ragdoll Update"), STAT_ALS_RagdollUpdate, STATGROUP_ALS);
+
 AALSBaseCharacter::AALSBaseCharacter(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<UALSCharacterMovementComponent>(CharacterMovementComponentName))
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// All per-frame work runs in the batched update of UALSCharacterUpdateSubsystem. Blueprints implementing
+	// Event Tick turn the actor tick back on.
+	PrimaryActorTick.bCanEverTick = false;
 	MantleTimeline = CreateDefaultSubobject<UTimelineComponent>(FName(TEXT("MantleTimeline")));
 	bUseControllerRotationYaw = 0;
 	bReplicates = true;
 	SetReplicatingMovement(true);
+	QueryParams.AddIgnoredActor(this);
 }
 
 void AALSBaseCharacter::Restart()
@@ -42,6 +51,15 @@ void AALSBaseCharacter::Restart()
 	{
 		NewController->OnRestartPawn(this);
 	}
+
+	// Movement input of the player is applied by the update subsystem, after the controller processed the input
+	APlayerController* PlayerController = Cast<APlayerController>(GetController());
+	if (PlayerController && PlayerController->IsLocalController())
+	{
+		UALSCharacterUpdateSubsystem* UpdateSubsystem = GetWorld()->GetSubsystem<UALSCharacterUpdateSubsystem>();
+		check(UpdateSubsystem);
+		UpdateSubsystem->AddPlayerController(PlayerController);
+	}
 }
 
 void AALSBaseCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -100,7 +118,9 @@ void AALSBaseCharacter::OnBreakfall_Implementation()
 void AALSBaseCharacter::Replicated_PlayMontage_Implementation(UAnimMontage* montage, float track)
 {
 	// Roll: Simply play a Root Motion Montage.
+	SetDormant(false);
 	MainAnimInstance->Montage_Play(montage, track);
+	ALS_COUNT_RPC();
 	Server_PlayMontage(montage, track);
 }
 
@@ -120,20 +140,16 @@ void AALSBaseCharacter::BeginPlay()
 	MantleTimeline->SetTimelineLengthMode(TL_TimelineLength);
 	MantleTimeline->AddInterpFloat(MantleTimelineCurve, TimelineUpdated);
 
-	// Make sure the mesh and animbp update after the CharacterBP to ensure it gets the most recent values.
-	GetMesh()->AddTickPrerequisiteActor(this);
+	BaseMeshTickInterval = GetMesh()->PrimaryComponentTick.TickInterval;
 
 	// Set the Movement Model
 	SetMovementModel();
 
 	// Once, force set variables in anim bp. This ensures anim instance & character starts synchronized
-	FALSAnimCharacterInformation& AnimData = MainAnimInstance->GetCharacterInformationMutable();
 	MainAnimInstance->Gait = DesiredGait;
 	MainAnimInstance->Stance = DesiredStance;
 	MainAnimInstance->RotationMode = DesiredRotationMode;
-	AnimData.ViewMode = ViewMode;
 	MainAnimInstance->OverlayState = OverlayState;
-	AnimData.PrevMovementState = PrevMovementState;
 	MainAnimInstance->MovementState = MovementState;
 
 	// Update states to use the initial desired values.
@@ -157,10 +173,27 @@ void AALSBaseCharacter::BeginPlay()
 	LastVelocityRotation = TargetRotation;
 	LastMovementInputRotation = TargetRotation;
 
+	PublishAnimCharacterInformation();
+
 	if (GetLocalRole() == ROLE_SimulatedProxy)
 	{
 		MainAnimInstance->SetRootMotionMode(ERootMotionMode::IgnoreRootMotion);
 	}
+
+	// Essential values, movement and rotation are updated in one batch together with other ALS characters
+	UALSCharacterUpdateSubsystem* UpdateSubsystem = GetWorld()->GetSubsystem<UALSCharacterUpdateSubsystem>();
+	check(UpdateSubsystem);
+	UpdateSubsystem->RegisterCharacter(this);
+}
+
+void AALSBaseCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UALSCharacterUpdateSubsystem* UpdateSubsystem = GetWorld()->GetSubsystem<UALSCharacterUpdateSubsystem>())
+	{
+		UpdateSubsystem->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AALSBaseCharacter::PreInitializeComponents()
@@ -180,16 +213,55 @@ void AALSBaseCharacter::PreInitializeComponents()
 void AALSBaseCharacter::SetAimYawRate(float NewAimYawRate)
 {
 	AimYawRate = NewAimYawRate;
-	MainAnimInstance->GetCharacterInformationMutable().AimYawRate = AimYawRate;
 }
 
-void AALSBaseCharacter::Tick(float DeltaTime)
+void AALSBaseCharacter::UpdateFrame()
 {
-	Super::Tick(DeltaTime);
+	UpdateLatches();
+
+	PublishAnimCharacterInformation();
 
-	// Set required values
-	SetEssentialValues(DeltaTime);
+	DrawDebugSpheres();
+}
 
+void AALSBaseCharacter::PublishAnimCharacterInformation()
+{
+	FALSAnimCharacterInformation Information;
+	Information.AimingRotation = AimingRotation;
+	Information.CharacterActorRotation = GetActorRotation();
+	Information.Velocity = GetCharacterMovement()->Velocity;
+	Information.Acceleration = Acceleration;
+	Information.MovementInput = GetMovementInput();
+	Information.bIsMoving = bIsMoving;
+	Information.bHasMovementInput = bHasMovementInput;
+	Information.Speed = Speed;
+	Information.MovementInputAmount = MovementInputAmount;
+	Information.AimYawRate = AimYawRate;
+	Information.MovementDirection = MovementDirection;
+	Information.PrevMovementState = PrevMovementState;
+	Information.ViewMode = ViewMode;
+
+	const UCharacterMovementComponent* CharacterMovement = GetCharacterMovement();
+	Information.CapsuleLocation = GetCapsuleComponent()->GetComponentLocation();
+	Information.LastUpdateRotation = CharacterMovement->GetLastUpdateRotation();
+	Information.MaxAcceleration = CharacterMovement->GetMaxAcceleration();
+	Information.MaxBrakingDeceleration = CharacterMovement->GetMaxBrakingDeceleration();
+	Information.bIsMovingOnGround = CharacterMovement->IsMovingOnGround();
+	Information.TimeToLand = GetTimeToLand();
+	Information.LandImpactLocation = LandPrediction.ImpactLocation;
+	Information.bLocallyControlledPlayer = IsLocallyControlled() && IsPlayerControlled();
+	Information.bAutonomousProxy = GetLocalRole() == ROLE_AutonomousProxy;
+
+	const FALSQualityTierSettings& QualitySettings = GetQualitySettings();
+	Information.bDynamicTransitions = QualitySettings.bDynamicTransitions;
+	Information.bFootIK = QualitySettings.bFootIK;
+	Information.bFullFootIK = QualitySettings.bFullFootIK;
+
+	MainAnimInstance->PublishCharacterInformation(Information);
+}
+
+void AALSBaseCharacter::UpdateCharacterState(float DeltaTime)
+{
 	if (MovementState == EALSMovementState::Grounded)
 	{
 		UpdateCharacterMovement();
@@ -198,9 +270,10 @@ void AALSBaseCharacter::Tick(float DeltaTime)
 	else if (MovementState == EALSMovementState::InAir)
 	{
 		UpdateInAirRotation(DeltaTime);
+		UpdateLandPrediction();
 
 		// Perform a mantle check if falling while movement input is pressed.
-		if (bHasMovementInput)
+		if (bHasMovementInput && GetQualitySettings().bFallingMantleChecks)
 		{
 			MantleCheck(FallingTraceSettings);
 		}
@@ -213,8 +286,6 @@ void AALSBaseCharacter::Tick(float DeltaTime)
 	// Cache values
 	PreviousVelocity = GetVelocity();
 	PreviousAimYaw = AimingRotation.Yaw;
-
-	DrawDebugSpheres();
 }
 
 void AALSBaseCharacter::RagdollStart()
@@ -228,8 +299,9 @@ void AALSBaseCharacter::RagdollStart()
 		DefVisBasedTickOp = GetMesh()->VisibilityBasedAnimTickOption;
 		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
 	}
-	TargetRagdollLocation = GetMesh()->GetSocketLocation(FName(TEXT("Pelvis")));
+	TargetRagdollLocation = BoneCache.GetSocketLocation(GetMesh(), EALSBoneSocket::Pelvis);
 	ServerRagdollPull = 0;
+	ALS_TRACE_RAGDOLL(this, true);
 
 	// Step 1: Clear the Character Movement Mode and set the Movement State to Ragdoll
 	GetCharacterMovement()->SetMovementMode(MOVE_None);
@@ -259,6 +331,7 @@ void AALSBaseCharacter::RagdollEnd()
 
 	MyCharacterMovementComponent->bIgnoreClientMovementErrorChecksAndCorrection = 0;
 	SetReplicateMovement(true);
+	ALS_TRACE_RAGDOLL(this, false);
 
 	if (!MainAnimInstance)
 	{
@@ -298,10 +371,10 @@ void AALSBaseCharacter::SetMovementState(const EALSMovementState NewState)
 {
 	if (MovementState != NewState)
 	{
+		SetDormant(false);
+		ALS_TRACE_STATE_CHANGE(this, MovementState, MovementState, NewState);
 		PrevMovementState = MovementState;
 		MovementState = NewState;
-		FALSAnimCharacterInformation& AnimData = MainAnimInstance->GetCharacterInformationMutable();
-		AnimData.PrevMovementState = PrevMovementState;
 		MainAnimInstance->MovementState = MovementState;
 		OnMovementStateChanged(PrevMovementState);
 	}
@@ -311,6 +384,7 @@ void AALSBaseCharacter::SetMovementAction(const EALSMovementAction NewAction)
 {
 	if (MovementAction != NewAction)
 	{
+		SetDormant(false);
 		const EALSMovementAction Prev = MovementAction;
 		MovementAction = NewAction;
 		MainAnimInstance->MovementAction = MovementAction;
@@ -322,8 +396,10 @@ void AALSBaseCharacter::SetStance(const EALSStance NewStance)
 {
 	if (Stance != NewStance)
 	{
+		SetDormant(false);
 		const EALSStance Prev = Stance;
 		Stance = NewStance;
+		bMovementSettingsDirty = true;
 		MainAnimInstance->Stance = Stance;
 		OnStanceChanged(Prev);
 	}
@@ -333,6 +409,8 @@ void AALSBaseCharacter::SetGait(const EALSGait NewGait)
 {
 	if (Gait != NewGait)
 	{
+		SetDormant(false);
+		ALS_TRACE_STATE_CHANGE(this, Gait, Gait, NewGait);
 		Gait = NewGait;
 		MainAnimInstance->Gait = Gait;
 	}
@@ -342,8 +420,10 @@ void AALSBaseCharacter::SetGait(const EALSGait NewGait)
 void AALSBaseCharacter::SetDesiredStance(EALSStance NewStance)
 {
 	DesiredStance = NewStance;
+	SetDormant(false);
 	if (GetLocalRole() == ROLE_AutonomousProxy)
 	{
+		ALS_COUNT_RPC();
 		Server_SetDesiredStance(NewStance);
 	}
 }
@@ -356,8 +436,10 @@ void AALSBaseCharacter::Server_SetDesiredStance_Implementation(EALSStance NewSta
 void AALSBaseCharacter::SetDesiredGait(const EALSGait NewGait)
 {
 	DesiredGait = NewGait;
+	SetDormant(false);
 	if (GetLocalRole() == ROLE_AutonomousProxy)
 	{
+		ALS_COUNT_RPC();
 		Server_SetDesiredGait(NewGait);
 	}
 }
@@ -370,9 +452,11 @@ void AALSBaseCharacter::Server_SetDesiredGait_Implementation(EALSGait NewGait)
 void AALSBaseCharacter::SetDesiredRotationMode(EALSRotationMode NewRotMode)
 {
 	DesiredRotationMode = NewRotMode;
+	SetDormant(false);
 
 	if (GetLocalRole() == ROLE_AutonomousProxy)
 	{
+		ALS_COUNT_RPC();
 		Server_SetDesiredRotationMode(NewRotMode);
 	}
 }
@@ -386,12 +470,16 @@ void AALSBaseCharacter::SetRotationMode(const EALSRotationMode NewRotationMode)
 {
 	if (RotationMode != NewRotationMode)
 	{
+		SetDormant(false);
+		ALS_TRACE_STATE_CHANGE(this, RotationMode, RotationMode, NewRotationMode);
 		const EALSRotationMode Prev = RotationMode;
 		RotationMode = NewRotationMode;
+		bMovementSettingsDirty = true;
 		OnRotationModeChanged(Prev);
 
 		if (GetLocalRole() == ROLE_AutonomousProxy)
 		{
+			ALS_COUNT_RPC();
 			Server_SetRotationMode(NewRotationMode);
 		}
 	}
@@ -406,12 +494,15 @@ void AALSBaseCharacter::SetViewMode(const EALSViewMode NewViewMode)
 {
 	if (ViewMode != NewViewMode)
 	{
+		SetDormant(false);
+		ALS_TRACE_STATE_CHANGE(this, ViewMode, ViewMode, NewViewMode);
 		const EALSViewMode Prev = ViewMode;
 		ViewMode = NewViewMode;
 		OnViewModeChanged(Prev);
 
 		if (GetLocalRole() == ROLE_AutonomousProxy)
 		{
+			ALS_COUNT_RPC();
 			Server_SetViewMode(NewViewMode);
 		}
 	}
@@ -426,12 +517,15 @@ void AALSBaseCharacter::SetOverlayState(const EALSOverlayState NewState)
 {
 	if (OverlayState != NewState)
 	{
+		SetDormant(false);
+		ALS_TRACE_STATE_CHANGE(this, OverlayState, OverlayState, NewState);
 		const EALSOverlayState Prev = OverlayState;
 		OverlayState = NewState;
 		OnOverlayStateChanged(Prev);
 
 		if (GetLocalRole() == ROLE_AutonomousProxy)
 		{
+			ALS_COUNT_RPC();
 			Server_SetOverlayState(NewState);
 		}
 	}
@@ -460,8 +554,7 @@ void AALSBaseCharacter::EventOnLanded()
 		GetCharacterMovement()->BrakingFrictionFactor = bHasMovementInput ? 0.5f : 3.0f;
 
 		// After 0.5 secs, reset braking friction factor to zero
-		GetWorldTimerManager().SetTimer(OnLandedFrictionResetTimer, this,
-		                                &AALSBaseCharacter::OnLandFrictionReset, 0.5f, false);
+		LandedFrictionResetLatch.Set(GetWorld()->GetTimeSeconds(), 0.5f);
 	}
 }
 
@@ -484,6 +577,7 @@ void AALSBaseCharacter::Server_MantleStart_Implementation(float MantleHeight,
                                                           const FALSComponentAndTransform& MantleLedgeWS,
                                                           EALSMantleType MantleType)
 {
+	ALS_COUNT_RPC();
 	Multicast_MantleStart(MantleHeight, MantleLedgeWS, MantleType);
 }
 
@@ -499,11 +593,13 @@ void AALSBaseCharacter::Multicast_MantleStart_Implementation(float MantleHeight,
 
 void AALSBaseCharacter::Server_PlayMontage_Implementation(UAnimMontage* montage, float track)
 {
+	ALS_COUNT_RPC();
 	Multicast_PlayMontage(montage, track);
 }
 
 void AALSBaseCharacter::Multicast_PlayMontage_Implementation(UAnimMontage* montage, float track)
 {
+	SetDormant(false);
 	if (!IsLocallyControlled())
 	{
 		// Roll: Simply play a Root Motion Montage.
@@ -521,6 +617,7 @@ void AALSBaseCharacter::Multicast_OnJumped_Implementation()
 
 void AALSBaseCharacter::Server_RagdollStart_Implementation()
 {
+	ALS_COUNT_RPC();
 	Multicast_RagdollStart();
 }
 
@@ -531,6 +628,7 @@ void AALSBaseCharacter::Multicast_RagdollStart_Implementation()
 
 void AALSBaseCharacter::Server_RagdollEnd_Implementation(FVector CharacterLocation)
 {
+	ALS_COUNT_RPC();
 	Multicast_RagdollEnd(CharacterLocation);
 }
 
@@ -562,88 +660,38 @@ void AALSBaseCharacter::SetMovementModel()
 		MovementModel.DataTable->FindRow<FALSMovementStateSettings>(MovementModel.RowName, ContextString);
 	check(OutRow);
 	MovementData = *OutRow;
+	MovementSettingsTable.Build(MovementData);
+	bMovementSettingsDirty = true;
 }
 
 void AALSBaseCharacter::SetHasMovementInput(bool bNewHasMovementInput)
 {
 	bHasMovementInput = bNewHasMovementInput;
-	MainAnimInstance->GetCharacterInformationMutable().bHasMovementInput = bHasMovementInput;
 }
 
 FALSMovementSettings AALSBaseCharacter::GetTargetMovementSettings() const
 {
-	if (RotationMode == EALSRotationMode::VelocityDirection)
-	{
-		if (Stance == EALSStance::Standing)
-		{
-			return MovementData.VelocityDirection.Standing;
-		}
-		if (Stance == EALSStance::Crouching)
-		{
-			return MovementData.VelocityDirection.Crouching;
-		}
-	}
-	else if (RotationMode == EALSRotationMode::LookingDirection)
-	{
-		if (Stance == EALSStance::Standing)
-		{
-			return MovementData.LookingDirection.Standing;
-		}
-		if (Stance == EALSStance::Crouching)
-		{
-			return MovementData.LookingDirection.Crouching;
-		}
-	}
-	else if (RotationMode == EALSRotationMode::Aiming)
-	{
-		if (Stance == EALSStance::Standing)
-		{
-			return MovementData.Aiming.Standing;
-		}
-		if (Stance == EALSStance::Crouching)
-		{
-			return MovementData.Aiming.Crouching;
-		}
-	}
-
-	// Default to velocity dir standing
-	return MovementData.VelocityDirection.Standing;
+	return MovementSettingsTable.Get(RotationMode, Stance);
 }
 
 bool AALSBaseCharacter::CanSprint() const
 {
-	// Determine if the character is currently able to sprint based on the Rotation mode and current acceleration
-	// (input) rotation. If the character is in the Looking Rotation mode, only allow sprinting if there is full
-	// movement input and it is faced forward relative to the camera + or - 50 degrees.
-
-	if (!bHasMovementInput || RotationMode == EALSRotationMode::Aiming)
-	{
-		return false;
-	}
-
-	const bool bValidInputAmount = MovementInputAmount > 0.9f;
-
-	if (RotationMode == EALSRotationMode::VelocityDirection)
-	{
-		return bValidInputAmount;
-	}
+	return FALSLocomotionCore::CanSprint(GetGaitState());
+}
 
-	if (RotationMode == EALSRotationMode::LookingDirection)
+float AALSBaseCharacter::GetTimeToLand() const
+{
+	if (MovementState != EALSMovementState::InAir)
 	{
-		const FRotator AccRot = ReplicatedCurrentAcceleration.ToOrientationRotator();
-		FRotator Delta = AccRot - AimingRotation;
-		Delta.Normalize();
-
-		return bValidInputAmount && FMath::Abs(Delta.Yaw) < 50.0f;
+		return -1.0f;
 	}
 
-	return false;
+	return LandPrediction.GetTimeToLand(GetWorld()->GetTimeSeconds());
 }
 
 void AALSBaseCharacter::SetIsMoving(bool bNewIsMoving)
 {
 	bIsMoving = bNewIsMoving;
-	MainAnimInstance->GetCharacterInformationMutable().bIsMoving = bIsMoving;
 }
 
 FVector AALSBaseCharacter::GetMovementInput() const
@@ -654,13 +702,11 @@ FVector AALSBaseCharacter::GetMovementInput() const
 void AALSBaseCharacter::SetMovementInputAmount(float NewMovementInputAmount)
 {
 	MovementInputAmount = NewMovementInputAmount;
-	MainAnimInstance->GetCharacterInformationMutable().MovementInputAmount = MovementInputAmount;
 }
 
 void AALSBaseCharacter::SetSpeed(float NewSpeed)
 {
 	Speed = NewSpeed;
-	MainAnimInstance->GetCharacterInformationMutable().Speed = Speed;
 }
 
 float AALSBaseCharacter::GetAnimCurveValue(FName CurveName) const
@@ -687,7 +733,7 @@ FTransform AALSBaseCharacter::GetThirdPersonPivotTarget()
 
 FVector AALSBaseCharacter::GetFirstPersonCameraTarget()
 {
-	return GetMesh()->GetSocketLocation(FName(TEXT("FP_Camera")));
+	return BoneCache.GetSocketLocation(GetMesh(), EALSBoneSocket::FP_Camera);
 }
 
 void AALSBaseCharacter::GetCameraParameters(float& TPFOVOut, float& FPFOVOut, bool& bRightShoulderOut) const
@@ -702,11 +748,12 @@ void AALSBaseCharacter::SetAcceleration(const FVector& NewAcceleration)
 	Acceleration = (NewAcceleration != FVector::ZeroVector || IsLocallyControlled())
 		               ? NewAcceleration
 		               : Acceleration / 2;
-	MainAnimInstance->GetCharacterInformationMutable().Acceleration = Acceleration;
 }
 
 void AALSBaseCharacter::RagdollUpdate(float DeltaTime)
 {
+	ALS_SCOPE_CYCLE_COUNTER(RagdollUpdate);
+
 	// Set the Last Ragdoll Velocity.
 	const FVector NewRagdollVel = GetMesh()->GetPhysicsLinearVelocity(FName(TEXT("root")));
 	LastRagdollVelocity = (NewRagdollVel != FVector::ZeroVector || IsLocallyControlled())
@@ -732,15 +779,16 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(float DeltaTime)
 	if (IsLocallyControlled())
 	{
 		// Set the pelvis as the target location.
-		TargetRagdollLocation = GetMesh()->GetSocketLocation(FName(TEXT("Pelvis")));
+		TargetRagdollLocation = BoneCache.GetSocketLocation(GetMesh(), EALSBoneSocket::Pelvis);
 		if (!HasAuthority())
 		{
+			ALS_COUNT_RPC();
 			Server_SetMeshLocationDuringRagdoll(TargetRagdollLocation);
 		}
 	}
 
 	// Determine wether the ragdoll is facing up or down and set the target rotation accordingly.
-	const FRotator PelvisRot = GetMesh()->GetSocketRotation(FName(TEXT("Pelvis")));
+	const FRotator PelvisRot = BoneCache.GetSocketRotation(GetMesh(), EALSBoneSocket::Pelvis);
 
 	bRagdollFaceUp = PelvisRot.Roll < 0.0f;
 
@@ -751,12 +799,11 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(float DeltaTime)
 	const FVector TraceVect(TargetRagdollLocation.X, TargetRagdollLocation.Y,
 	                        TargetRagdollLocation.Z - GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
 
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
-
-	FHitResult HitResult;
-	GetWorld()->LineTraceSingleByChannel(HitResult, TargetRagdollLocation, TraceVect,
-	                                     ECC_Visibility, Params);
+	UALSSceneQuerySubsystem* SceneQueries = GetWorld()->GetSubsystem<UALSSceneQuerySubsystem>();
+	check(SceneQueries);
+	const FHitResult& HitResult = SceneQueries->LineTraceSingleByChannel(
+		RagdollGroundQuery, EALSSceneQuerySystem::Ragdoll, TargetRagdollLocation, TraceVect, ECC_Visibility,
+		QueryParams);
 
 	bRagdollOnGround = HitResult.IsValidBlockingHit();
 	FVector NewRagdollLoc = TargetRagdollLocation;
@@ -800,6 +847,9 @@ void AALSBaseCharacter::OnMovementStateChanged(const EALSMovementState PreviousS
 {
 	if (MovementState == EALSMovementState::InAir)
 	{
+		// Predict the landing of the new fall
+		LandPrediction.Invalidate();
+
 		if (MovementAction == EALSMovementAction::None)
 		{
 			// If the character enters the air, set the In Air Rotation and uncrouch if crouched.
@@ -819,6 +869,7 @@ void AALSBaseCharacter::OnMovementStateChanged(const EALSMovementState PreviousS
 	{
 		// Stop the Mantle Timeline if transitioning to the ragdoll state while mantling.
 		MantleTimeline->Stop();
+		bMantleUpdatePending = false;
 	}
 }
 
@@ -864,7 +915,6 @@ void AALSBaseCharacter::OnGaitChanged(const EALSGait PreviousGait)
 
 void AALSBaseCharacter::OnViewModeChanged(const EALSViewMode PreviousViewMode)
 {
-	MainAnimInstance->GetCharacterInformationMutable().ViewMode = ViewMode;
 	if (ViewMode == EALSViewMode::ThirdPerson)
 	{
 		if (RotationMode == EALSRotationMode::VelocityDirection || RotationMode == EALSRotationMode::LookingDirection)
@@ -908,6 +958,7 @@ void AALSBaseCharacter::OnJumped_Implementation()
 	}
 	if (HasAuthority())
 	{
+		ALS_COUNT_RPC();
 		Multicast_OnJumped();
 	}
 }
@@ -922,6 +973,7 @@ void AALSBaseCharacter::Landed(const FHitResult& Hit)
 	}
 	if (HasAuthority())
 	{
+		ALS_COUNT_RPC();
 		Multicast_OnLanded();
 	}
 }
@@ -932,60 +984,17 @@ void AALSBaseCharacter::OnLandFrictionReset()
 	GetCharacterMovement()->BrakingFrictionFactor = 0.0f;
 }
 
-void AALSBaseCharacter::SetEssentialValues(float DeltaTime)
+void AALSBaseCharacter::UpdateLatches()
 {
-	if (GetLocalRole() != ROLE_SimulatedProxy)
-	{
-		ReplicatedCurrentAcceleration = GetCharacterMovement()->GetCurrentAcceleration();
-		ReplicatedControlRotation = GetControlRotation();
-		EasedMaxAcceleration = GetCharacterMovement()->GetMaxAcceleration();
-	}
-
-	else
+	const float Time = GetWorld()->GetTimeSeconds();
+	if (LandedFrictionResetLatch.Poll(Time))
 	{
-		EasedMaxAcceleration = GetCharacterMovement()->GetMaxAcceleration() != 0
-			                       ? GetCharacterMovement()->GetMaxAcceleration()
-			                       : EasedMaxAcceleration / 2;
+		OnLandFrictionReset();
 	}
-
-	// Interp AimingRotation to current control rotation for smooth character rotation movement. Decrease InterpSpeed
-	// for slower but smoother movement.
-	AimingRotation = FMath::RInterpTo(AimingRotation, ReplicatedControlRotation, DeltaTime, 30);
-
-	// These values represent how the capsule is moving as well as how it wants to move, and therefore are essential
-	// for any data driven animation system. They are also used throughout the system for various functions,
-	// so I found it is easiest to manage them all in one place.
-
-	const FVector CurrentVel = GetVelocity();
-
-	// Set the amount of Acceleration.
-	SetAcceleration((CurrentVel - PreviousVelocity) / DeltaTime);
-
-	// Determine if the character is moving by getting it's speed. The Speed equals the length of the horizontal (x y)
-	// velocity, so it does not take vertical movement into account. If the character is moving, update the last
-	// velocity rotation. This value is saved because it might be useful to know the last orientation of movement
-	// even after the character has stopped.
-	SetSpeed(CurrentVel.Size2D());
-	SetIsMoving(Speed > 1.0f);
-	if (bIsMoving)
+	if (CameraModeSwapLatch.Poll(Time))
 	{
-		LastVelocityRotation = CurrentVel.ToOrientationRotator();
+		OnSwitchCameraMode();
 	}
-
-	// Determine if the character has movement input by getting its movement input amount.
-	// The Movement Input Amount is equal to the current acceleration divided by the max acceleration so that
-	// it has a range of 0-1, 1 being the maximum possible amount of input, and 0 being none.
-	// If the character has movement input, update the Last Movement Input Rotation.
-	SetMovementInputAmount(ReplicatedCurrentAcceleration.Size() / EasedMaxAcceleration);
-	SetHasMovementInput(MovementInputAmount > 0.0f);
-	if (bHasMovementInput)
-	{
-		LastMovementInputRotation = ReplicatedCurrentAcceleration.ToOrientationRotator();
-	}
-
-	// Set the Aim Yaw rate by comparing the current and previous Aim Yaw value, divided by Delta Seconds.
-	// This represents the speed the camera is rotating left to right.
-	SetAimYawRate(FMath::Abs((AimingRotation.Yaw - PreviousAimYaw) / DeltaTime));
 }
 
 void AALSBaseCharacter::UpdateCharacterMovement()
@@ -993,6 +1002,20 @@ void AALSBaseCharacter::UpdateCharacterMovement()
 	// Set the Allowed Gait
 	const EALSGait AllowedGait = GetAllowedGait();
 
+	// Pick the Current Movement Settings from the table only when the rotation mode or stance has changed,
+	// the max speed target only when the settings or the Allowed Gait have changed.
+	const bool bMaxSpeedDirty = bMovementSettingsDirty || AllowedGait != MaxSpeedAllowedGait;
+	if (bMovementSettingsDirty)
+	{
+		CurrentMovementSettings = GetTargetMovementSettings();
+		bMovementSettingsDirty = false;
+	}
+	if (bMaxSpeedDirty)
+	{
+		MaxSpeedAllowedGait = AllowedGait;
+		TargetMaxSpeed = CurrentMovementSettings.GetSpeedForGait(AllowedGait);
+	}
+
 	// Determine the Actual Gait. If it is different from the current Gait, Set the new Gait Event.
 	const EALSGait ActualGait = GetActualGait(AllowedGait);
 
@@ -1005,55 +1028,55 @@ void AALSBaseCharacter::UpdateCharacterMovement()
 	if (bDisableCurvedMovement)
 	{
 		// Don't use curves for movement
-		UpdateDynamicMovementSettingsNetworked(AllowedGait);
+		UpdateDynamicMovementSettingsNetworked();
 	}
 	else
 	{
 		// Use curves for movement
-		UpdateDynamicMovementSettingsStandalone(AllowedGait);
+		UpdateDynamicMovementSettingsStandalone(bMaxSpeedDirty);
 	}
 }
 
-void AALSBaseCharacter::UpdateDynamicMovementSettingsStandalone(EALSGait AllowedGait)
+void AALSBaseCharacter::UpdateDynamicMovementSettingsStandalone(bool bMaxSpeedDirty)
 {
-	// Get the Current Movement Settings.
-	CurrentMovementSettings = GetTargetMovementSettings();
-	const float NewMaxSpeed = CurrentMovementSettings.GetSpeedForGait(AllowedGait);
-
 	// Update the Acceleration, Deceleration, and Ground Friction using the Movement Curve.
 	// This allows for fine control over movement behavior at each speed (May not be suitable for replication).
 	const float MappedSpeed = GetMappedSpeed();
-	const FVector CurveVec = CurrentMovementSettings.MovementCurve->GetVectorValue(MappedSpeed);
+	const FVector CurveVec = MovementCurveTable.GetVectorValue(CurrentMovementSettings.MovementCurve, MappedSpeed);
 
 	// Update the Character Max Walk Speed to the configured speeds based on the currently Allowed Gait.
-	MyCharacterMovementComponent->SetMaxWalkingSpeed(NewMaxSpeed);
+	if (bMaxSpeedDirty)
+	{
+		MyCharacterMovementComponent->SetMaxWalkingSpeed(TargetMaxSpeed);
+	}
 	GetCharacterMovement()->MaxAcceleration = CurveVec.X;
 	GetCharacterMovement()->BrakingDecelerationWalking = CurveVec.Y;
 	GetCharacterMovement()->GroundFriction = CurveVec.Z;
 }
 
-void AALSBaseCharacter::UpdateDynamicMovementSettingsNetworked(EALSGait AllowedGait)
+void AALSBaseCharacter::UpdateDynamicMovementSettingsNetworked()
 {
-	// Get the Current Movement Settings.
-	CurrentMovementSettings = GetTargetMovementSettings();
-	const float NewMaxSpeed = CurrentMovementSettings.GetSpeedForGait(AllowedGait);
-
 	// Update the Character Max Walk Speed to the configured speeds based on the currently Allowed Gait.
 	if (IsLocallyControlled() || HasAuthority())
 	{
-		if (GetCharacterMovement()->MaxWalkSpeed != NewMaxSpeed)
+		if (GetCharacterMovement()->MaxWalkSpeed != TargetMaxSpeed)
 		{
-			MyCharacterMovementComponent->SetMaxWalkingSpeed(NewMaxSpeed);
+			MyCharacterMovementComponent->SetMaxWalkingSpeed(TargetMaxSpeed);
 		}
 	}
 	else
 	{
-		GetCharacterMovement()->MaxWalkSpeed = NewMaxSpeed;
+		GetCharacterMovement()->MaxWalkSpeed = TargetMaxSpeed;
 	}
 }
 
 void AALSBaseCharacter::UpdateGroundedRotation(float DeltaTime)
 {
+	ALS_SCOPE_CYCLE_COUNTER(UpdateGroundedRotation);
+
+	// The anim instance of an anim sharing follower is not updated, its curves would keep their last values
+	const FALSAnimCurveValues* CurveValues = AnimSharingLeader ? nullptr : &MainAnimInstance->GetCurveValues();
+
 	if (MovementAction == EALSMovementAction::None)
 	{
 		const bool bCanUpdateMovingRot = ((bIsMoving && bHasMovementInput) || Speed > 150.0f) && !HasAnyRootMotion();
@@ -1077,7 +1100,7 @@ void AALSBaseCharacter::UpdateGroundedRotation(float DeltaTime)
 				else
 				{
 					// Walking or Running..
-					const float YawOffsetCurveVal = MainAnimInstance->GetCurveValue(FName(TEXT("YawOffset")));
+					const float YawOffsetCurveVal = CurveValues ? CurveValues->Get(EALSAnimCurve::YawOffset) : 0.0f;
 					YawValue = AimingRotation.Yaw + YawOffsetCurveVal;
 				}
 				SmoothCharacterRotation({0.0f, YawValue, 0.0f}, 500.0f, GroundedRotationRate, DeltaTime);
@@ -1102,7 +1125,7 @@ void AALSBaseCharacter::UpdateGroundedRotation(float DeltaTime)
 			// The Rotation Amount curve defines how much rotation should be applied each frame,
 			// and is calculated for animations that are animated at 30fps.
 
-			const float RotAmountCurve = MainAnimInstance->GetCurveValue(FName(TEXT("RotationAmount")));
+			const float RotAmountCurve = CurveValues ? CurveValues->Get(EALSAnimCurve::RotationAmount) : 0.0f;
 
 			if (FMath::Abs(RotAmountCurve) > 0.001f)
 			{
@@ -1148,6 +1171,22 @@ void AALSBaseCharacter::UpdateInAirRotation(float DeltaTime)
 	}
 }
 
+void AALSBaseCharacter::UpdateLandPrediction()
+{
+	if (!GetQualitySettings().bLandPrediction)
+	{
+		LandPrediction.Invalidate();
+		return;
+	}
+
+	// The arc is only swept again once the character no longer follows it
+	const float Time = GetWorld()->GetTimeSeconds();
+	if (LandPrediction.IsInvalidated(*this, Time))
+	{
+		LandPrediction.Predict(*this, QueryParams, Time);
+	}
+}
+
 void AALSBaseCharacter::MantleStart(float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
                                     EALSMantleType MantleType)
 {
@@ -1208,6 +1247,8 @@ void AALSBaseCharacter::MantleStart(float MantleHeight, const FALSComponentAndTr
 
 bool AALSBaseCharacter::MantleCheck(const FALSMantleTraceSettings& TraceSettings, EDrawDebugTrace::Type DebugType)
 {
+	ALS_SCOPE_CYCLE_COUNTER(MantleCheck);
+
 	// Step 1: Trace forward to find a wall / object the character cannot walk on.
 	const FVector& CapsuleBaseLocation = UALSMathLibrary::GetCapsuleBaseLocation(2.0f, GetCapsuleComponent());
 	FVector TraceStart = CapsuleBaseLocation + GetPlayerMovementInput() * -30.0f;
@@ -1218,17 +1259,19 @@ bool AALSBaseCharacter::MantleCheck(const FALSMantleTraceSettings& TraceSettings
 	UWorld* World = GetWorld();
 	check(World);
 
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
-
 	FHitResult HitResult;
 	// ECC_GameTraceChannel2 -> Climbable
-	World->SweepSingleByChannel(HitResult, TraceStart, TraceEnd, FQuat::Identity, ECC_GameTraceChannel2,
-	                            FCollisionShape::MakeCapsule(TraceSettings.ForwardTraceRadius, HalfHeight), Params);
+	{
+		ALS_SCOPE_TRACE();
+		World->SweepSingleByChannel(HitResult, TraceStart, TraceEnd, FQuat::Identity, ECC_GameTraceChannel2,
+		                            FCollisionShape::MakeCapsule(TraceSettings.ForwardTraceRadius, HalfHeight),
+		                            QueryParams);
+	}
 
 	if (!HitResult.IsValidBlockingHit() || GetCharacterMovement()->IsWalkable(HitResult))
 	{
 		// Not a valid surface to mantle
+		ALS_TRACE_MANTLE(this, NoWall);
 		return false;
 	}
 	
@@ -1238,6 +1281,7 @@ bool AALSBaseCharacter::MantleCheck(const FALSMantleTraceSettings& TraceSettings
 		if (PrimitiveComponent && PrimitiveComponent->GetComponentVelocity().Size() > AcceptableVelocityWhileMantling)
 		{
 			// The surface to mantle moves too fast
+			ALS_TRACE_MANTLE(this, MovingSurface);
 			return false;
 		}
 	}
@@ -1252,14 +1296,18 @@ bool AALSBaseCharacter::MantleCheck(const FALSMantleTraceSettings& TraceSettings
 	FVector DownwardTraceStart = DownwardTraceEnd;
 	DownwardTraceStart.Z += TraceSettings.MaxLedgeHeight + TraceSettings.DownwardTraceRadius + 1.0f;
 
-	World->SweepSingleByChannel(HitResult, DownwardTraceStart, DownwardTraceEnd, FQuat::Identity,
-	                            ECC_GameTraceChannel2, FCollisionShape::MakeSphere(TraceSettings.DownwardTraceRadius),
-	                            Params);
+	{
+		ALS_SCOPE_TRACE();
+		World->SweepSingleByChannel(HitResult, DownwardTraceStart, DownwardTraceEnd, FQuat::Identity,
+		                            ECC_GameTraceChannel2,
+		                            FCollisionShape::MakeSphere(TraceSettings.DownwardTraceRadius), QueryParams);
+	}
 
 
 	if (!GetCharacterMovement()->IsWalkable(HitResult))
 	{
 		// Not a valid surface to mantle
+		ALS_TRACE_MANTLE(this, NoWalkableLedge);
 		return false;
 	}
 
@@ -1276,6 +1324,7 @@ bool AALSBaseCharacter::MantleCheck(const FALSMantleTraceSettings& TraceSettings
 	if (!bCapsuleHasRoom)
 	{
 		// Capsule doesn't have enough room to mantle
+		ALS_TRACE_MANTLE(this, NoRoom);
 		return false;
 	}
 
@@ -1301,7 +1350,9 @@ bool AALSBaseCharacter::MantleCheck(const FALSMantleTraceSettings& TraceSettings
 	FALSComponentAndTransform MantleWS;
 	MantleWS.Component = HitComponent;
 	MantleWS.Transform = TargetTransform;
+	ALS_TRACE_MANTLE(this, Started);
 	MantleStart(MantleHeight, MantleWS, MantleType);
+	ALS_COUNT_RPC();
 	Server_MantleStart(MantleHeight, MantleWS, MantleType);
 
 	return true;
@@ -1310,63 +1361,9 @@ bool AALSBaseCharacter::MantleCheck(const FALSMantleTraceSettings& TraceSettings
 // This function is called by "MantleTimeline" using BindUFunction in the AALSBaseCharacter::BeginPlay during the default settings initalization.
 void AALSBaseCharacter::MantleUpdate(float BlendIn)
 {
-	// Step 1: Continually update the mantle target from the stored local transform to follow along with moving objects
-	MantleTarget = UALSMathLibrary::MantleComponentLocalToWorld(MantleLedgeLS);
-
-	// Step 2: Update the Position and Correction Alphas using the Position/Correction curve set for each Mantle.
-	const FVector CurveVec = MantleParams.PositionCorrectionCurve
-	                                     ->GetVectorValue(
-		                                     MantleParams.StartingPosition + MantleTimeline->GetPlaybackPosition());
-	const float PositionAlpha = CurveVec.X;
-	const float XYCorrectionAlpha = CurveVec.Y;
-	const float ZCorrectionAlpha = CurveVec.Z;
-
-	// Step 3: Lerp multiple transforms together for independent control over the horizontal
-	// and vertical blend to the animated start position, as well as the target position.
-
-	// Blend into the animated horizontal and rotation offset using the Y value of the Position/Correction Curve.
-	const FTransform TargetHzTransform(MantleAnimatedStartOffset.GetRotation(),
-	                                   {
-		                                   MantleAnimatedStartOffset.GetLocation().X,
-		                                   MantleAnimatedStartOffset.GetLocation().Y,
-		                                   MantleActualStartOffset.GetLocation().Z
-	                                   },
-	                                   FVector::OneVector);
-	const FTransform& HzLerpResult =
-		UKismetMathLibrary::TLerp(MantleActualStartOffset, TargetHzTransform, XYCorrectionAlpha);
-
-	// Blend into the animated vertical offset using the Z value of the Position/Correction Curve.
-	const FTransform TargetVtTransform(MantleActualStartOffset.GetRotation(),
-	                                   {
-		                                   MantleActualStartOffset.GetLocation().X,
-		                                   MantleActualStartOffset.GetLocation().Y,
-		                                   MantleAnimatedStartOffset.GetLocation().Z
-	                                   },
-	                                   FVector::OneVector);
-	const FTransform& VtLerpResult =
-		UKismetMathLibrary::TLerp(MantleActualStartOffset, TargetVtTransform, ZCorrectionAlpha);
-
-	const FTransform ResultTransform(HzLerpResult.GetRotation(),
-	                                 {
-		                                 HzLerpResult.GetLocation().X, HzLerpResult.GetLocation().Y,
-		                                 VtLerpResult.GetLocation().Z
-	                                 },
-	                                 FVector::OneVector);
-
-	// Blend from the currently blending transforms into the final mantle target using the X
-	// value of the Position/Correction Curve.
-	const FTransform& ResultLerp = UKismetMathLibrary::TLerp(
-		UALSMathLibrary::TransfromAdd(MantleTarget, ResultTransform), MantleTarget,
-		PositionAlpha);
-
-	// Initial Blend In (controlled in the timeline curve) to allow the actor to blend into the Position/Correction
-	// curve at the midoint. This prevents pops when mantling an object lower than the animated mantle.
-	const FTransform& LerpedTarget =
-		UKismetMathLibrary::TLerp(UALSMathLibrary::TransfromAdd(MantleTarget, MantleActualStartOffset), ResultLerp,
-		                          BlendIn);
-
-	// Step 4: Set the actors location and rotation to the Lerped Target.
-	SetActorLocationAndTargetRotation(LerpedTarget.GetLocation(), LerpedTarget.GetRotation().Rotator());
+	// The mantle transforms of all mantling characters are blended together by UALSCharacterUpdateSubsystem
+	MantleBlendIn = BlendIn;
+	bMantleUpdatePending = true;
 }
 
 void AALSBaseCharacter::MantleEnd()
@@ -1377,89 +1374,38 @@ void AALSBaseCharacter::MantleEnd()
 
 float AALSBaseCharacter::GetMappedSpeed() const
 {
-	// Map the character's current speed to the configured movement speeds with a range of 0-3,
-	// with 0 = stopped, 1 = the Walk Speed, 2 = the Run Speed, and 3 = the Sprint Speed.
-	// This allows us to vary the movement speeds but still use the mapped range in calculations for consistent results
-
-	const float LocWalkSpeed = CurrentMovementSettings.WalkSpeed;
-	const float LocRunSpeed = CurrentMovementSettings.RunSpeed;
-	const float LocSprintSpeed = CurrentMovementSettings.SprintSpeed;
-
-	if (Speed > LocRunSpeed)
-	{
-		return FMath::GetMappedRangeValueClamped({LocRunSpeed, LocSprintSpeed}, {2.0f, 3.0f}, Speed);
-	}
-
-	if (Speed > LocWalkSpeed)
-	{
-		return FMath::GetMappedRangeValueClamped({LocWalkSpeed, LocRunSpeed}, {1.0f, 2.0f}, Speed);
-	}
-
-	return FMath::GetMappedRangeValueClamped({0.0f, LocWalkSpeed}, {0.0f, 1.0f}, Speed);
+	return FALSLocomotionCore::GetMappedSpeed(Speed, CurrentMovementSettings);
 }
 
 EALSGait AALSBaseCharacter::GetAllowedGait() const
 {
-	// Calculate the Allowed Gait. This represents the maximum Gait the character is currently allowed to be in,
-	// and can be determined by the desired gait, the rotation mode, the stance, etc. For example,
-	// if you wanted to force the character into a walking state while indoors, this could be done here.
-
-	if (Stance == EALSStance::Standing)
-	{
-		if (RotationMode != EALSRotationMode::Aiming)
-		{
-			if (DesiredGait == EALSGait::Sprinting)
-			{
-				return CanSprint() ? EALSGait::Sprinting : EALSGait::Running;
-			}
-			return DesiredGait;
-		}
-	}
-
-	// Crouching stance & Aiming rot mode has same behaviour
-
-	if (DesiredGait == EALSGait::Sprinting)
-	{
-		return EALSGait::Running;
-	}
-
-	return DesiredGait;
+	return FALSLocomotionCore::GetAllowedGait(GetGaitState());
 }
 
 EALSGait AALSBaseCharacter::GetActualGait(EALSGait AllowedGait) const
 {
-	// Get the Actual Gait. This is calculated by the actual movement of the character,  and so it can be different
-	// from the desired gait or allowed gait. For instance, if the Allowed Gait becomes walking,
-	// the Actual gait will still be running untill the character decelerates to the walking speed.
-
-	const float LocWalkSpeed = CurrentMovementSettings.WalkSpeed;
-	const float LocRunSpeed = CurrentMovementSettings.RunSpeed;
-
-	if (Speed > LocRunSpeed + 10.0f)
-	{
-		if (AllowedGait == EALSGait::Sprinting)
-		{
-			return EALSGait::Sprinting;
-		}
-		return EALSGait::Running;
-	}
-
-	if (Speed >= LocWalkSpeed + 10.0f)
-	{
-		return EALSGait::Running;
-	}
+	return FALSLocomotionCore::GetActualGait(GetGaitState(), CurrentMovementSettings, AllowedGait);
+}
 
-	return EALSGait::Walking;
+FALSGaitState AALSBaseCharacter::GetGaitState() const
+{
+	FALSGaitState State;
+	State.Stance = Stance;
+	State.RotationMode = RotationMode;
+	State.DesiredGait = DesiredGait;
+	State.bHasMovementInput = bHasMovementInput;
+	State.MovementInputAmount = MovementInputAmount;
+	State.MovementInput = ReplicatedCurrentAcceleration;
+	State.AimingRotation = AimingRotation;
+	State.Speed = Speed;
+	return State;
 }
 
 void AALSBaseCharacter::SmoothCharacterRotation(FRotator Target, float TargetInterpSpeed, float ActorInterpSpeed,
                                                 float DeltaTime)
 {
-	// Interpolate the Target Rotation for extra smooth rotation behavior
-	TargetRotation =
-		FMath::RInterpConstantTo(TargetRotation, Target, DeltaTime, TargetInterpSpeed);
-	SetActorRotation(
-		FMath::RInterpTo(GetActorRotation(), TargetRotation, DeltaTime, ActorInterpSpeed));
+	SetActorRotation(FALSLocomotionCore::SmoothRotation(GetActorRotation(), TargetRotation, Target, TargetInterpSpeed,
+	                                                    ActorInterpSpeed, DeltaTime));
 }
 
 float AALSBaseCharacter::CalculateGroundedRotationRate() const
@@ -1470,7 +1416,7 @@ float AALSBaseCharacter::CalculateGroundedRotationRate() const
 
 	const float MappedSpeedVal = GetMappedSpeed();
 	const float CurveVal =
-		CurrentMovementSettings.RotationRateCurve->GetFloatValue(MappedSpeedVal);
+		RotationRateCurveTable.GetFloatValue(CurrentMovementSettings.RotationRateCurve, MappedSpeedVal);
 	const float ClampedAimYawRate = FMath::GetMappedRangeValueClamped({0.0f, 300.0f}, {1.0f, 3.0f}, AimYawRate);
 	return CurveVal * ClampedAimYawRate;
 }
@@ -1490,6 +1436,89 @@ void AALSBaseCharacter::LimitRotation(float AimYawMin, float AimYawMax, float In
 	}
 }
 
+void AALSBaseCharacter::SetDormant(bool bNewDormant)
+{
+	if (bDormant == bNewDormant)
+	{
+		return;
+	}
+
+	bDormant = bNewDormant;
+	DormancyIdleTime = 0.0f;
+
+	if (bDormant)
+	{
+		bActorTickEnabledBeforeDormancy = IsActorTickEnabled();
+		SetActorTickEnabled(false);
+		GetMesh()->SetComponentTickInterval(DormantMeshTickInterval);
+	}
+	else
+	{
+		SetActorTickEnabled(bActorTickEnabledBeforeDormancy);
+		GetMesh()->SetComponentTickInterval(GetMeshTickInterval());
+	}
+}
+
+void AALSBaseCharacter::SetQualityTier(EALSQualityTier NewTier)
+{
+	if (QualityTier == NewTier)
+	{
+		return;
+	}
+
+	QualityTier = NewTier;
+
+	// Dormant characters get the interval of their tier when they wake up
+	if (!bDormant)
+	{
+		GetMesh()->SetComponentTickInterval(GetMeshTickInterval());
+	}
+}
+
+float AALSBaseCharacter::GetMeshTickInterval() const
+{
+	return FMath::Max(BaseMeshTickInterval, GetQualitySettings().MeshTickInterval);
+}
+
+void AALSBaseCharacter::SetAnimSharingLeader(AALSBaseCharacter* NewLeader)
+{
+	if (AnimSharingLeader == NewLeader)
+	{
+		return;
+	}
+
+	if (!NewLeader && IsValid(AnimSharingLeader) && AnimSharingLeader->MainAnimInstance)
+	{
+		MainAnimInstance->BeginSharedPoseBlendOut(*AnimSharingLeader->MainAnimInstance);
+	}
+
+	AnimSharingLeader = NewLeader;
+
+	// The master pose replaces the bone evaluation, skipping the skeleton update skips the animation update too
+	USkeletalMeshComponent* MeshComponent = GetMesh();
+	MeshComponent->SetMasterPoseComponent(NewLeader ? NewLeader->GetMesh() : nullptr);
+	MeshComponent->bNoSkeletonUpdate = NewLeader != nullptr;
+}
+
+bool AALSBaseCharacter::CanShareAnimation() const
+{
+	// The player is always animated on its own
+	return MovementState == EALSMovementState::Grounded
+		&& MovementAction == EALSMovementAction::None
+		&& MainAnimInstance && !MainAnimInstance->IsAnyMontagePlaying()
+		&& !(IsLocallyControlled() && IsPlayerControlled());
+}
+
+uint32 AALSBaseCharacter::GetAnimSharingKey() const
+{
+	// Only grounded characters share, the movement state is left out
+	return static_cast<uint32>(Gait)
+		| static_cast<uint32>(Stance) << 6
+		| static_cast<uint32>(RotationMode) << 12
+		| static_cast<uint32>(OverlayState) << 18
+		| static_cast<uint32>(bIsMoving) << 24;
+}
+
 void AALSBaseCharacter::GetControlForwardRightVector(FVector& Forward, FVector& Right) const
 {
 	const FRotator ControlRot(0.0f, AimingRotation.Yaw, 0.0f);
@@ -1507,25 +1536,26 @@ FVector AALSBaseCharacter::GetPlayerMovementInput() const
 
 void AALSBaseCharacter::PlayerForwardMovementInput(float Value)
 {
-	if (MovementState == EALSMovementState::Grounded || MovementState == EALSMovementState::InAir)
+	if (Value != 0.0f)
 	{
-		// Default camera relative movement behavior
-		const float Scale = UALSMathLibrary::FixDiagonalGamepadValues(Value, GetInputAxisValue("MoveRight/Left")).Key;
-		const FRotator DirRotator(0.0f, AimingRotation.Yaw, 0.0f);
-		AddMovementInput(UKismetMathLibrary::GetForwardVector(DirRotator), Scale);
+		SetDormant(false);
 	}
+
+	// Applied together with the right input by UALSCharacterUpdateSubsystem, which fixes up the diagonal gamepad
+	// values of all players at once
+	PlayerMovementInputAxes.X = Value;
+	bPlayerMovementInputPending = true;
 }
 
 void AALSBaseCharacter::PlayerRightMovementInput(float Value)
 {
-	if (MovementState == EALSMovementState::Grounded || MovementState == EALSMovementState::InAir)
+	if (Value != 0.0f)
 	{
-		// Default camera relative movement behavior
-		const float Scale = UALSMathLibrary::FixDiagonalGamepadValues(GetInputAxisValue("MoveForward/Backwards"), Value)
-			.Value;
-		const FRotator DirRotator(0.0f, AimingRotation.Yaw, 0.0f);
-		AddMovementInput(UKismetMathLibrary::GetRightVector(DirRotator), Scale);
+		SetDormant(false);
 	}
+
+	PlayerMovementInputAxes.Y = Value;
+	bPlayerMovementInputPending = true;
 }
 
 void AALSBaseCharacter::PlayerCameraUpInput(float Value)
@@ -1612,8 +1642,7 @@ void AALSBaseCharacter::CameraPressedAction()
 	UWorld* World = GetWorld();
 	check(World);
 	CameraActionPressedTime = World->GetTimeSeconds();
-	GetWorldTimerManager().SetTimer(OnCameraModeSwapTimer, this,
-	                                &AALSBaseCharacter::OnSwitchCameraMode, ViewModeSwitchHoldTime, false);
+	CameraModeSwapLatch.Set(CameraActionPressedTime, ViewModeSwitchHoldTime);
 }
 
 void AALSBaseCharacter::CameraReleasedAction()
@@ -1630,7 +1659,7 @@ void AALSBaseCharacter::CameraReleasedAction()
 	{
 		// Switch shoulders
 		SetRightShoulder(!bRightShoulder);
-		GetWorldTimerManager().ClearTimer(OnCameraModeSwapTimer); // Prevent mode change
+		CameraModeSwapLatch.Clear(); // Prevent mode change
 	}
 }
 
@@ -1740,10 +1769,12 @@ void AALSBaseCharacter::ReplicatedRagdollStart()
 {
 	if (HasAuthority())
 	{
+		ALS_COUNT_RPC();
 		Multicast_RagdollStart();
 	}
 	else
 	{
+		ALS_COUNT_RPC();
 		Server_RagdollStart();
 	}
 }
@@ -1752,25 +1783,34 @@ void AALSBaseCharacter::ReplicatedRagdollEnd()
 {
 	if (HasAuthority())
 	{
+		ALS_COUNT_RPC();
 		Multicast_RagdollEnd(GetActorLocation());
 	}
 	else
 	{
+		ALS_COUNT_RPC();
 		Server_RagdollEnd(GetActorLocation());
 	}
 }
 
 void AALSBaseCharacter::OnRep_RotationMode(EALSRotationMode PrevRotMode)
 {
+	SetDormant(false);
+	ALS_TRACE_STATE_CHANGE(this, RotationMode, PrevRotMode, RotationMode);
+	bMovementSettingsDirty = true;
 	OnRotationModeChanged(PrevRotMode);
 }
 
 void AALSBaseCharacter::OnRep_ViewMode(EALSViewMode PrevViewMode)
 {
+	SetDormant(false);
+	ALS_TRACE_STATE_CHANGE(this, ViewMode, PrevViewMode, ViewMode);
 	OnViewModeChanged(PrevViewMode);
 }
 
 void AALSBaseCharacter::OnRep_OverlayState(EALSOverlayState PrevOverlayState)
 {
+	SetDormant(false);
+	ALS_TRACE_STATE_CHANGE(this, OverlayState, PrevOverlayState, OverlayState);
 	OnOverlayStateChanged(PrevOverlayState);
 }
@@ -0,0 +1,144 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/ALSBudgetGovernor.h"
+
+#include "Benchmark/ALSBenchmarkTimers.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarBudget(
+	TEXT("ALS.Budget"),
+	0,
+	TEXT("If non zero, quality tiers of ALS characters are lowered while ALS exceeds its CPU budget."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarBudgetMs(
+	TEXT("ALS.Budget.Ms"),
+	4.0f,
+	TEXT("CPU time in milliseconds all ALS characters may use per frame, summed over all threads."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarBudgetHeadroom(
+	TEXT("ALS.Budget.Headroom"),
+	0.8f,
+	TEXT("Fraction of the budget the ALS cost has to stay below before quality tiers are raised again."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarBudgetRampUp(
+	TEXT("ALS.Budget.RampUp"),
+	0.05f,
+	TEXT("Fraction of all quality tiers given back per evaluation while below the headroom."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarBudgetInterval(
+	TEXT("ALS.Budget.Interval"),
+	0.25f,
+	TEXT("Seconds the ALS cost is averaged over before the quality tiers are evaluated again."),
+	ECVF_Default);
+
+namespace
+{
+	constexpr int32 MaxTierSteps = static_cast<int32>(EALSQualityTier::Minimal);
+}
+
+const FALSQualityTierSettings& FALSQualityTierSettings::Get(EALSQualityTier Tier)
+{
+	static const FALSQualityTierSettings Settings[] = {
+		// FullFootIK, FootIK, LandPrediction, DynamicTransitions, FallingMantleChecks, UpdateInterval, MeshTickInterval
+		{true, true, true, true, true, 0.0f, 0.0f},
+		{false, true, true, true, true, 1.0f / 30.0f, 1.0f / 30.0f},
+		{false, false, false, false, true, 1.0f / 15.0f, 1.0f / 15.0f},
+		{false, false, false, false, false, 1.0f / 10.0f, 1.0f / 10.0f},
+	};
+	static_assert(UE_ARRAY_COUNT(Settings) == MaxTierSteps + 1, "Every quality tier needs settings");
+
+	return Settings[static_cast<uint8>(Tier)];
+}
+
+bool FALSBudgetGovernor::IsEnabled()
+{
+	return CVarBudget.GetValueOnGameThread() != 0;
+}
+
+bool FALSBudgetGovernor::Update(float DeltaTime, int32 NumCharacters)
+{
+	if (!FALSBenchmarkTimers::IsEnabled())
+	{
+		FALSBenchmarkTimers::SetEnabled(true);
+		bEnabledTimers = true;
+	}
+
+	// Scene queries are measured inside the other phases
+	const uint64 Cycles = FALSBenchmarkTimers::GetCycles(EALSBenchmarkPhase::CharacterTick) +
+		FALSBenchmarkTimers::GetCycles(EALSBenchmarkPhase::AnimUpdate) +
+		FALSBenchmarkTimers::GetCycles(EALSBenchmarkPhase::Camera);
+
+	// The first sample only sets the baseline, cycles counted before the governor was enabled are not its cost
+	if (!bMeasuring)
+	{
+		bMeasuring = true;
+		LastCycles = Cycles;
+		return false;
+	}
+
+	// The benchmark resets the timers between its runs
+	IntervalCycles += Cycles >= LastCycles ? Cycles - LastCycles : Cycles;
+	LastCycles = Cycles;
+	++IntervalFrames;
+	IntervalTime += DeltaTime;
+	if (IntervalTime < CVarBudgetInterval.GetValueOnGameThread())
+	{
+		return false;
+	}
+
+	CostMs = FPlatformTime::ToMilliseconds64(IntervalCycles) / IntervalFrames;
+	IntervalCycles = 0;
+	IntervalFrames = 0;
+	IntervalTime = 0.0f;
+
+	const int32 MaxLoweredTiers = NumCharacters * MaxTierSteps;
+	const float BudgetMs = CVarBudgetMs.GetValueOnGameThread();
+	if (CostMs > BudgetMs)
+	{
+		// Lower the tiers in proportion to the overshoot
+		const float Overshoot = (CostMs - BudgetMs) / CostMs;
+		LoweredTiers += FMath::Max(1, FMath::CeilToInt((MaxLoweredTiers - LoweredTiers) * Overshoot));
+	}
+	else if (CostMs < BudgetMs * CVarBudgetHeadroom.GetValueOnGameThread())
+	{
+		// Raise them slowly, so the cost settles below the budget instead of oscillating around it
+		LoweredTiers -= FMath::Max(1, FMath::CeilToInt(MaxLoweredTiers * CVarBudgetRampUp.GetValueOnGameThread()));
+	}
+	LoweredTiers = FMath::Clamp(LoweredTiers, 0, MaxLoweredTiers);
+
+	return true;
+}
+
+EALSQualityTier FALSBudgetGovernor::GetTier(int32 Rank) const
+{
+	// The least significant character is lowered all the way before the next one is lowered
+	return static_cast<EALSQualityTier>(FMath::Clamp(LoweredTiers - Rank * MaxTierSteps, 0, MaxTierSteps));
+}
+
+void FALSBudgetGovernor::Reset()
+{
+	// Stop measuring, unless the timers are used by the benchmark
+	if (bEnabledTimers)
+	{
+		FALSBenchmarkTimers::SetEnabled(false);
+		bEnabledTimers = false;
+	}
+
+	bMeasuring = false;
+	LastCycles = 0;
+	IntervalCycles = 0;
+	IntervalFrames = 0;
+	IntervalTime = 0.0f;
+	CostMs = 0.0f;
+	LoweredTiers = 0;
+}
@@ -0,0 +1,55 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/ALSCameraBehaviorDataAsset.h"
+
+namespace
+{
+	template <typename EnumType>
+	bool MatchesState(const TArray<EnumType>& States, EnumType State)
+	{
+		return States.Num() == 0 || States.Contains(State);
+	}
+}
+
+int32 UALSCameraBehaviorDataAsset::FindEntry(EALSViewMode ViewMode, EALSRotationMode RotationMode,
+                                             EALSMovementState MovementState, EALSMovementAction MovementAction,
+                                             EALSGait Gait, EALSStance Stance) const
+{
+	return Entries.IndexOfByPredicate([&](const FALSCameraBehaviorEntry& Entry)
+	{
+		return MatchesState(Entry.ViewModes, ViewMode)
+			&& MatchesState(Entry.RotationModes, RotationMode)
+			&& MatchesState(Entry.MovementStates, MovementState)
+			&& MatchesState(Entry.MovementActions, MovementAction)
+			&& MatchesState(Entry.Gaits, Gait)
+			&& MatchesState(Entry.Stances, Stance);
+	});
+}
+
+FALSCameraBehaviorParams UALSCameraBehaviorDataAsset::GetParams(int32 EntryIndex, bool bRightShoulder) const
+{
+	if (!Entries.IsValidIndex(EntryIndex))
+	{
+		return DefaultParams;
+	}
+
+	const FALSCameraBehaviorEntry& Entry = Entries[EntryIndex];
+	FALSCameraBehaviorParams Params = Entry.Params;
+	if (!bRightShoulder && Entry.bMirrorLeftShoulder)
+	{
+		Params.PivotOffset.Y = -Params.PivotOffset.Y;
+		Params.CameraOffset.Y = -Params.CameraOffset.Y;
+	}
+	return Params;
+}
+
+float UALSCameraBehaviorDataAsset::GetBlendInTime(int32 EntryIndex) const
+{
+	return Entries.IsValidIndex(EntryIndex) ? Entries[EntryIndex].BlendInTime : DefaultBlendInTime;
+}
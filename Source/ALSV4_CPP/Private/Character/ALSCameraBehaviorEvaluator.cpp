@@ -0,0 +1,69 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/ALSCameraBehaviorEvaluator.h"
+
+#include "Character/ALSBaseCharacter.h"
+#include "Character/ALSCameraBehaviorDataAsset.h"
+
+const FALSCameraBehaviorParams& FALSCameraBehaviorEvaluator::Update(const UALSCameraBehaviorDataAsset& Data,
+                                                                    const AALSBaseCharacter& Character,
+                                                                    bool bRightShoulder, float DeltaTime)
+{
+	// Step 1: Find the entry of the character state
+	const int32 EntryIndex = Data.FindEntry(Character.GetViewMode(), Character.GetRotationMode(),
+	                                        Character.GetMovementState(), Character.GetMovementAction(),
+	                                        Character.GetGait(), Character.GetStance());
+
+	// Step 2: Start a new blend from the current params when the target changed
+	if (!bInitialized)
+	{
+		bInitialized = true;
+		BlendDuration = 0.0f;
+	}
+	else if (EntryIndex != TargetEntryIndex || bRightShoulder != bTargetRightShoulder)
+	{
+		SourceParams = Params;
+		BlendTime = 0.0f;
+		BlendDuration = Data.GetBlendInTime(EntryIndex);
+	}
+	TargetEntryIndex = EntryIndex;
+	bTargetRightShoulder = bRightShoulder;
+
+	// Step 3: Advance the blend. The target params are read every update, so edits to the asset show up right away.
+	const FALSCameraBehaviorParams TargetParams = Data.GetParams(EntryIndex, bRightShoulder);
+	if (BlendDuration > 0.0f)
+	{
+		BlendTime = FMath::Min(BlendTime + DeltaTime, BlendDuration);
+		Params = Blend(SourceParams, TargetParams, BlendTime / BlendDuration);
+		if (BlendTime >= BlendDuration)
+		{
+			BlendTime = 0.0f;
+			BlendDuration = 0.0f;
+		}
+	}
+	else
+	{
+		Params = TargetParams;
+	}
+
+	return Params;
+}
+
+FALSCameraBehaviorParams FALSCameraBehaviorEvaluator::Blend(const FALSCameraBehaviorParams& A,
+                                                            const FALSCameraBehaviorParams& B, float Alpha)
+{
+	FALSCameraBehaviorParams Result;
+	Result.RotationLagSpeed = FMath::Lerp(A.RotationLagSpeed, B.RotationLagSpeed, Alpha);
+	Result.PivotLagSpeed = FMath::Lerp(A.PivotLagSpeed, B.PivotLagSpeed, Alpha);
+	Result.PivotOffset = FMath::Lerp(A.PivotOffset, B.PivotOffset, Alpha);
+	Result.CameraOffset = FMath::Lerp(A.CameraOffset, B.CameraOffset, Alpha);
+	Result.OverrideDebug = FMath::Lerp(A.OverrideDebug, B.OverrideDebug, Alpha);
+	Result.WeightFirstPerson = FMath::Lerp(A.WeightFirstPerson, B.WeightFirstPerson, Alpha);
+	return Result;
+}
@@ -79,8 +79,10 @@ void AALSCharacter::RagdollEnd()
 
 ECollisionChannel AALSCharacter::GetThirdPersonTraceParams(FVector& TraceOrigin, float& TraceRadius)
 {
-	const FName CameraSocketName = bRightShoulder ? TEXT("TP_CameraTrace_R") : TEXT("TP_CameraTrace_L");
-	TraceOrigin = GetMesh()->GetSocketLocation(CameraSocketName);
+	const EALSBoneSocket CameraSocket = bRightShoulder
+		                                    ? EALSBoneSocket::TP_CameraTrace_R
+		                                    : EALSBoneSocket::TP_CameraTrace_L;
+	TraceOrigin = BoneCache.GetSocketLocation(GetMesh(), CameraSocket);
 	TraceRadius = 15.0f;
 	return ECC_Camera;
 }
@@ -88,13 +90,14 @@ ECollisionChannel AALSCharacter::GetThirdPersonTraceParams(FVector& TraceOrigin,
 FTransform AALSCharacter::GetThirdPersonPivotTarget()
 {
 	return FTransform(GetActorRotation(),
-	                  (GetMesh()->GetSocketLocation(TEXT("Head")) + GetMesh()->GetSocketLocation(TEXT("root"))) / 2.0f,
+	                  (BoneCache.GetSocketLocation(GetMesh(), EALSBoneSocket::Head) +
+		                  BoneCache.GetSocketLocation(GetMesh(), EALSBoneSocket::Root)) / 2.0f,
 	                  FVector::OneVector);
 }
 
 FVector AALSCharacter::GetFirstPersonCameraTarget()
 {
-	return GetMesh()->GetSocketLocation(TEXT("FP_Camera"));
+	return BoneCache.GetSocketLocation(GetMesh(), EALSBoneSocket::FP_Camera);
 }
 
 void AALSCharacter::OnOverlayStateChanged(EALSOverlayState PreviousState)
@@ -103,9 +106,9 @@ void AALSCharacter::OnOverlayStateChanged(EALSOverlayState PreviousState)
 	UpdateHeldObject();
 }
 
-void AALSCharacter::Tick(float DeltaTime)
+void AALSCharacter::UpdateFrame()
 {
-	Super::Tick(DeltaTime);
+	Super::UpdateFrame();
 	UpdateHeldObjectAnimations();
 }
 
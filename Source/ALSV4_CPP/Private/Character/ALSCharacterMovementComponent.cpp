@@ -6,6 +6,7 @@
 
 #include "Character/ALSCharacterMovementComponent.h"
 #include "Character/ALSBaseCharacter.h"
+#include "Library/ALSStats.h"
 
 UALSCharacterMovementComponent::UALSCharacterMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -104,6 +105,7 @@ void UALSCharacterMovementComponent::SetMaxWalkingSpeed(float NewMaxWalkSpeed)
 	if (PawnOwner->IsLocallyControlled())
 	{
 		MyNewMaxWalkSpeed = NewMaxWalkSpeed;
+		ALS_COUNT_RPC();
 		Server_SetMaxWalkingSpeed(NewMaxWalkSpeed);
 	}
 	bRequestMovementSettingsChange = true;
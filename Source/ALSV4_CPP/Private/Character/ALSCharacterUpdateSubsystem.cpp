@@ -0,0 +1,982 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/ALSCharacterUpdateSubsystem.h"
+
+#include "Library/ALSStats.h"
+#include "Library/ALSMathLibrary.h"
+#include "Character/ALSBaseCharacter.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/TimelineComponent.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+
+DECLARE_CYCLE_STAT(TEXT("Update Characters"), STAT_ALS_UpdateCharacters, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Set Essential Values"), STAT_ALS_SetEssentialValues, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Update Quality Tiers"), STAT_ALS_UpdateQualityTiers, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Update Mantles"), STAT_ALS_UpdateMantles, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Apply Player Movement Input"), STAT_ALS_ApplyPlayerMovementInput, STATGROUP_ALS);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Budget Cost (ms)"), STAT_ALS_BudgetCost, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lowered Quality Tiers"), STAT_ALS_LoweredQualityTiers, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Quality Tier High"), STAT_ALS_QualityTierHigh, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Quality Tier Medium"), STAT_ALS_QualityTierMedium, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Quality Tier Low"), STAT_ALS_QualityTierLow, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Quality Tier Minimal"), STAT_ALS_QualityTierMinimal, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Update Anim Sharing"), STAT_ALS_UpdateAnimSharing, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Sharing Leaders"), STAT_ALS_AnimSharingLeaders, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Sharing Followers"), STAT_ALS_AnimSharingFollowers, STATGROUP_ALS);
+
+static TAutoConsoleVariable<int32> CVarParallelEssentialValues(
+	TEXT("ALS.ParallelEssentialValues"),
+	0,
+	TEXT("If non zero, essential values of ALS characters are calculated in parallel across worker threads."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarParallelEssentialValuesMinBatch(
+	TEXT("ALS.ParallelEssentialValues.MinBatch"),
+	32,
+	TEXT("Minimum number of ALS characters required to calculate essential values in parallel."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarUpdateLOD(
+	TEXT("ALS.UpdateLOD"),
+	1,
+	TEXT("If non zero, ALS characters far away from all player view points are updated at a reduced rate."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarUpdateLODMidDistance(
+	TEXT("ALS.UpdateLOD.MidDistance"),
+	1500.0f,
+	TEXT("Distance from the nearest player view point after which ALS characters are updated at mid rate."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarUpdateLODFarDistance(
+	TEXT("ALS.UpdateLOD.FarDistance"),
+	5000.0f,
+	TEXT("Distance from the nearest player view point after which ALS characters are updated at far rate."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarUpdateLODMidRate(
+	TEXT("ALS.UpdateLOD.MidRate"),
+	20.0f,
+	TEXT("Update rate in Hz of ALS characters at mid range, and of nearby characters that are not rendered."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarUpdateLODFarRate(
+	TEXT("ALS.UpdateLOD.FarRate"),
+	5.0f,
+	TEXT("Update rate in Hz of ALS characters far away from all player view points."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarDormancy(
+	TEXT("ALS.Dormancy"),
+	1,
+	TEXT("If non zero, idle ALS characters become dormant until they are woken up by input, movement or a state change."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDormancyIdleTime(
+	TEXT("ALS.Dormancy.IdleTime"),
+	1.0f,
+	TEXT("Time in seconds an ALS character needs to stay idle before it becomes dormant."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAnimSharing(
+	TEXT("ALS.AnimSharing"),
+	0,
+	TEXT("If non zero, distant ALS characters in the same state copy the pose of a shared leader character. ")
+	TEXT("Needs the character AnimBP to blend out of SharedPoseSnapshot, otherwise leaving a group pops."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAnimSharingDistance(
+	TEXT("ALS.AnimSharing.Distance"),
+	4000.0f,
+	TEXT("Distance from the nearest player view point after which ALS characters start sharing their animation."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAnimSharingHysteresis(
+	TEXT("ALS.AnimSharing.Hysteresis"),
+	0.8f,
+	TEXT("Fraction of the anim sharing distance a sharing ALS character needs to come closer to stop sharing."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAnimSharingLeadersPerGroup(
+	TEXT("ALS.AnimSharing.LeadersPerGroup"),
+	2,
+	TEXT("Number of ALS characters that evaluate their own animation for each group of characters in the same state."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAnimSharingInterval(
+	TEXT("ALS.AnimSharing.Interval"),
+	0.5f,
+	TEXT("Time in seconds between regrouping ALS characters for anim sharing."),
+	ECVF_Default);
+
+void FALSCharacterHotState::SetNum(const int32 NewNum)
+{
+	DeltaTime.SetNum(NewNum, false);
+	Velocity.SetNum(NewNum, false);
+	PreviousVelocity.SetNum(NewNum, false);
+	CurrentAcceleration.SetNum(NewNum, false);
+	ControlRotation.SetNum(NewNum, false);
+	MaxAcceleration.SetNum(NewNum, false);
+	PreviousAimYaw.SetNum(NewNum, false);
+	bSimulatedProxy.SetNum(NewNum, false);
+	bLocallyControlled.SetNum(NewNum, false);
+	MovementState.SetNum(NewNum, false);
+	AimingRotation.SetNum(NewNum, false);
+	LastVelocityRotation.SetNum(NewNum, false);
+	LastMovementInputRotation.SetNum(NewNum, false);
+	Acceleration.SetNum(NewNum, false);
+	EasedMaxAcceleration.SetNum(NewNum, false);
+	Speed.SetNum(NewNum, false);
+	MovementInputAmount.SetNum(NewNum, false);
+	AimYawRate.SetNum(NewNum, false);
+	bIsMoving.SetNum(NewNum, false);
+	bHasMovementInput.SetNum(NewNum, false);
+	VelocityYawOffset.SetNum(NewNum, false);
+	MovementDirection.SetNum(NewNum, false);
+}
+
+void FALSCharacterHotState::SetEssentialValues(const int32 Index)
+{
+	const float Delta = DeltaTime[Index];
+
+	if (bSimulatedProxy[Index])
+	{
+		EasedMaxAcceleration[Index] = MaxAcceleration[Index] != 0
+			                              ? MaxAcceleration[Index]
+			                              : EasedMaxAcceleration[Index] / 2;
+	}
+	else
+	{
+		EasedMaxAcceleration[Index] = MaxAcceleration[Index];
+	}
+
+	// Interp AimingRotation to current control rotation for smooth character rotation movement. Decrease InterpSpeed
+	// for slower but smoother movement.
+	AimingRotation[Index] = FMath::RInterpTo(AimingRotation[Index], ControlRotation[Index], Delta, 30);
+
+	// These values represent how the capsule is moving as well as how it wants to move, and therefore are essential
+	// for any data driven animation system. They are also used throughout the system for various functions,
+	// so I found it is easiest to manage them all in one place.
+
+	const FVector& CurrentVel = Velocity[Index];
+
+	// Set the amount of Acceleration. Ease it out on remote characters when there is no new value.
+	const FVector NewAcceleration = (CurrentVel - PreviousVelocity[Index]) / Delta;
+	Acceleration[Index] = NewAcceleration != FVector::ZeroVector || bLocallyControlled[Index]
+		                      ? NewAcceleration
+		                      : Acceleration[Index] / 2;
+
+	// Determine if the character is moving by getting it's speed. The Speed equals the length of the horizontal (x y)
+	// velocity, so it does not take vertical movement into account. If the character is moving, update the last
+	// velocity rotation. This value is saved because it might be useful to know the last orientation of movement
+	// even after the character has stopped.
+	Speed[Index] = CurrentVel.Size2D();
+	bIsMoving[Index] = Speed[Index] > 1.0f;
+	if (bIsMoving[Index])
+	{
+		LastVelocityRotation[Index] = CurrentVel.ToOrientationRotator();
+	}
+
+	// Determine if the character has movement input by getting its movement input amount.
+	// The Movement Input Amount is equal to the current acceleration divided by the max acceleration so that
+	// it has a range of 0-1, 1 being the maximum possible amount of input, and 0 being none.
+	// If the character has movement input, update the Last Movement Input Rotation.
+	MovementInputAmount[Index] = CurrentAcceleration[Index].Size() / EasedMaxAcceleration[Index];
+	bHasMovementInput[Index] = MovementInputAmount[Index] > 0.0f;
+	if (bHasMovementInput[Index])
+	{
+		LastMovementInputRotation[Index] = CurrentAcceleration[Index].ToOrientationRotator();
+	}
+
+	// Set the Aim Yaw rate by comparing the current and previous Aim Yaw value, divided by Delta Seconds.
+	// This represents the speed the camera is rotating left to right.
+	AimYawRate[Index] = FMath::Abs((AimingRotation[Index].Yaw - PreviousAimYaw[Index]) / Delta);
+
+	// The movement direction quadrant is determined from this yaw for all characters at once
+	FRotator VelocityDelta = CurrentVel.ToOrientationRotator() - AimingRotation[Index];
+	VelocityDelta.Normalize();
+	VelocityYawOffset[Index] = VelocityDelta.Yaw;
+}
+
+void FALSMantleBatch::SetNum(const int32 NewNum)
+{
+	Target.SetNum(NewNum, false);
+	ActualStartOffset.SetNum(NewNum, false);
+	HorizontalTarget.SetNum(NewNum, false);
+	VerticalTarget.SetNum(NewNum, false);
+	XYCorrectionAlpha.SetNum(NewNum, false);
+	ZCorrectionAlpha.SetNum(NewNum, false);
+	HorizontalResult.SetNum(NewNum, false);
+	VerticalResult.SetNum(NewNum, false);
+	CorrectedStart.SetNum(NewNum, false);
+	PositionAlpha.SetNum(NewNum, false);
+	PositionResult.SetNum(NewNum, false);
+	ActualStart.SetNum(NewNum, false);
+	BlendIn.SetNum(NewNum, false);
+	LerpedTarget.SetNum(NewNum, false);
+}
+
+FALSCharacterUpdateTickFunction::FALSCharacterUpdateTickFunction()
+{
+	TickGroup = TG_PrePhysics;
+	bCanEverTick = true;
+	bStartWithTickEnabled = true;
+}
+
+void FALSCharacterUpdateTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType,
+                                                  ENamedThreads::Type CurrentThread,
+                                                  const FGraphEventRef& MyCompletionGraphEvent)
+{
+	// Characters don't tick in editor viewports, neither does their batched update
+	if (Target && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->UpdateCharacters(DeltaTime);
+	}
+}
+
+FString FALSCharacterUpdateTickFunction::DiagnosticMessage()
+{
+	return TEXT("FALSCharacterUpdateTickFunction");
+}
+
+FALSPlayerMovementInputTickFunction::FALSPlayerMovementInputTickFunction()
+{
+	TickGroup = TG_PrePhysics;
+	bCanEverTick = true;
+	bStartWithTickEnabled = true;
+}
+
+void FALSPlayerMovementInputTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType,
+                                                      ENamedThreads::Type CurrentThread,
+                                                      const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->ApplyPlayerMovementInput();
+	}
+}
+
+FString FALSPlayerMovementInputTickFunction::DiagnosticMessage()
+{
+	return TEXT("FALSPlayerMovementInputTickFunction");
+}
+
+void UALSCharacterUpdateSubsystem::Deinitialize()
+{
+	if (UpdateTickFunction.IsTickFunctionRegistered())
+	{
+		UpdateTickFunction.UnRegisterTickFunction();
+	}
+	UpdateTickFunction.Target = nullptr;
+	if (MovementInputTickFunction.IsTickFunctionRegistered())
+	{
+		MovementInputTickFunction.UnRegisterTickFunction();
+	}
+	MovementInputTickFunction.Target = nullptr;
+	Characters.Empty();
+	BudgetGovernor.Reset();
+
+	Super::Deinitialize();
+}
+
+void UALSCharacterUpdateSubsystem::RegisterCharacter(AALSBaseCharacter* Character)
+{
+	check(Character);
+
+	if (!UpdateTickFunction.IsTickFunctionRegistered())
+	{
+		UWorld* World = GetWorld();
+		check(World);
+		UpdateTickFunction.Target = this;
+		UpdateTickFunction.RegisterTickFunction(World->PersistentLevel);
+		MovementInputTickFunction.Target = this;
+		MovementInputTickFunction.RegisterTickFunction(World->PersistentLevel);
+	}
+
+	Characters.AddUnique(Character);
+
+	// Update after the character moved, like the character tick did, and before its mesh and animation read the
+	// values written by the update
+	UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	UpdateTickFunction.AddPrerequisite(CharacterMovement, CharacterMovement->PrimaryComponentTick);
+	Character->GetMesh()->PrimaryComponentTick.AddPrerequisite(this, UpdateTickFunction);
+
+	// The character moves with the player input applied this frame, and is mantled to where its timeline is
+	CharacterMovement->PrimaryComponentTick.AddPrerequisite(this, MovementInputTickFunction);
+	UpdateTickFunction.AddPrerequisite(Character->MantleTimeline, Character->MantleTimeline->PrimaryComponentTick);
+}
+
+void UALSCharacterUpdateSubsystem::AddPlayerController(APlayerController* PlayerController)
+{
+	check(PlayerController);
+	MovementInputTickFunction.AddPrerequisite(PlayerController, PlayerController->PrimaryActorTick);
+}
+
+void UALSCharacterUpdateSubsystem::UnregisterCharacter(AALSBaseCharacter* Character)
+{
+	const int32 Index = Characters.Find(Character);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (bUpdatingCharacters)
+	{
+		// Character got destroyed during the update, leave the slots empty until the update is finished
+		Characters[Index] = nullptr;
+		const int32 UpdatedIndex = UpdatedCharacters.Find(Character);
+		if (UpdatedIndex != INDEX_NONE)
+		{
+			UpdatedCharacters[UpdatedIndex] = nullptr;
+		}
+	}
+	else
+	{
+		Characters.RemoveAtSwap(Index);
+	}
+
+	if (AnimSharingLeaders.Remove(Character) > 0)
+	{
+		ReleaseAnimSharingFollowers(Character);
+	}
+
+	UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	UpdateTickFunction.RemovePrerequisite(CharacterMovement, CharacterMovement->PrimaryComponentTick);
+	Character->GetMesh()->PrimaryComponentTick.RemovePrerequisite(this, UpdateTickFunction);
+	CharacterMovement->PrimaryComponentTick.RemovePrerequisite(this, MovementInputTickFunction);
+	UpdateTickFunction.RemovePrerequisite(Character->MantleTimeline, Character->MantleTimeline->PrimaryComponentTick);
+}
+
+void UALSCharacterUpdateSubsystem::UpdateCharacters(float DeltaTime)
+{
+	ALS_BENCHMARK_SCOPE(CharacterTick);
+	ALS_SCOPE_CYCLE_COUNTER(UpdateCharacters);
+
+	Characters.RemoveAllSwap([](const AALSBaseCharacter* Character) { return !IsValid(Character); });
+	if (Characters.Num() == 0)
+	{
+		return;
+	}
+
+	bUpdatingCharacters = true;
+
+	// Step 1: Pick the characters that are due for an update this frame, at the rate of their quality tier
+	if (CVarUpdateLOD.GetValueOnGameThread() != 0 || FALSBudgetGovernor::IsEnabled()
+		|| CVarAnimSharing.GetValueOnGameThread() != 0)
+	{
+		GatherViewLocations();
+	}
+	UpdateQualityTiers(DeltaTime);
+	UpdateAnimSharing(DeltaTime);
+	GatherUpdatedCharacters(DeltaTime);
+
+	// Step 2: Copy the hot state of these characters into contiguous arrays
+	GatherHotState();
+
+	// Step 3: Calculate the essential values of all characters in one pass. Each character only reads and writes
+	// its own slots, so the pass can be split across worker threads.
+	const bool bParallel = CVarParallelEssentialValues.GetValueOnGameThread() != 0
+		&& HotState.Num() >= CVarParallelEssentialValuesMinBatch.GetValueOnGameThread()
+		&& FApp::ShouldUseThreadingForPerformance();
+	{
+		ALS_SCOPE_CYCLE_COUNTER(SetEssentialValues);
+		ParallelFor(HotState.Num(), [this](int32 Index)
+		{
+			HotState.SetEssentialValues(Index);
+		}, !bParallel);
+	}
+
+	// Step 4: Determine the quadrant of the velocity relative to the aiming rotation of all characters. It is used
+	// in the Looking Direction / Aiming rotation modes to blend to the appropriate directional states.
+	UALSMathLibrary::CalculateQuadrants(HotState.VelocityYawOffset, 70.0f, -70.0f, 110.0f, -110.0f, 5.0f,
+	                                    HotState.MovementDirection);
+
+	// Step 5: Write the results back and run the movement state dependent updates
+	for (int32 Index = 0; Index < UpdatedCharacters.Num(); ++Index)
+	{
+		AALSBaseCharacter* Character = UpdatedCharacters[Index];
+		if (IsValid(Character))
+		{
+			CommitHotState(Index);
+			Character->UpdateCharacterState(HotState.DeltaTime[Index]);
+			UpdateDormancy(Character, HotState.DeltaTime[Index]);
+		}
+	}
+
+	// Step 6: Move the mantling characters, their timelines advance every frame
+	UpdateMantles();
+
+	// Step 7: Run the per-frame work of all characters that are awake, including the ones skipped above
+	for (int32 Index = 0; Index < Characters.Num(); ++Index)
+	{
+		AALSBaseCharacter* Character = Characters[Index];
+		if (IsValid(Character) && !Character->bDormant)
+		{
+			Character->UpdateFrame();
+		}
+	}
+
+	UpdatedCharacters.Reset();
+	bUpdatingCharacters = false;
+}
+
+void UALSCharacterUpdateSubsystem::GatherViewLocations()
+{
+	ViewLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PlayerController = It->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+}
+
+void UALSCharacterUpdateSubsystem::UpdateQualityTiers(float DeltaTime)
+{
+	ALS_SCOPE_CYCLE_COUNTER(UpdateQualityTiers);
+
+	if (!FALSBudgetGovernor::IsEnabled())
+	{
+		if (bQualityTiersAssigned)
+		{
+			for (AALSBaseCharacter* Character : Characters)
+			{
+				Character->SetQualityTier(EALSQualityTier::High);
+			}
+			BudgetGovernor.Reset();
+			bQualityTiersAssigned = false;
+		}
+		return;
+	}
+
+	// Step 1: Measure the last frame, the tiers are only assigned when the governor re-evaluated them.
+	// Only characters that are not locally controlled players can be lowered.
+	int32 NumGovernedCharacters = 0;
+	for (const AALSBaseCharacter* Character : Characters)
+	{
+		if (!Character->IsLocallyControlled() || !Character->IsPlayerControlled())
+		{
+			++NumGovernedCharacters;
+		}
+	}
+
+	if (BudgetGovernor.Update(DeltaTime, NumGovernedCharacters) || !bQualityTiersAssigned)
+	{
+		bQualityTiersAssigned = true;
+
+		// Step 2: Rank the characters, least significant first. Characters that are not rendered come first,
+		// then by the distance to the nearest player view point.
+		struct FRankedCharacter
+		{
+			AALSBaseCharacter* Character;
+
+			float ViewDistanceSquared;
+
+			bool bRendered;
+		};
+
+		TArray<FRankedCharacter> RankedCharacters;
+		RankedCharacters.Reserve(Characters.Num());
+		FMemory::Memzero(NumCharactersPerTier);
+		for (AALSBaseCharacter* Character : Characters)
+		{
+			// The player always plays at full quality
+			if (Character->IsLocallyControlled() && Character->IsPlayerControlled())
+			{
+				Character->SetQualityTier(EALSQualityTier::High);
+				++NumCharactersPerTier[static_cast<uint8>(EALSQualityTier::High)];
+				continue;
+			}
+
+			const bool bRendered = IsRunningDedicatedServer() || Character->GetMesh()->WasRecentlyRendered(0.2f);
+			RankedCharacters.Add({Character, GetViewDistanceSquared(Character), bRendered});
+		}
+
+		RankedCharacters.Sort([](const FRankedCharacter& A, const FRankedCharacter& B)
+		{
+			if (A.bRendered != B.bRendered)
+			{
+				return !A.bRendered;
+			}
+			return A.ViewDistanceSquared > B.ViewDistanceSquared;
+		});
+
+		// Step 3: Assign the tiers
+		for (int32 Rank = 0; Rank < RankedCharacters.Num(); ++Rank)
+		{
+			const EALSQualityTier Tier = BudgetGovernor.GetTier(Rank);
+			RankedCharacters[Rank].Character->SetQualityTier(Tier);
+			++NumCharactersPerTier[static_cast<uint8>(Tier)];
+		}
+
+		CSV_CUSTOM_STAT(ALS, BudgetCostMs, BudgetGovernor.GetCostMs(), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(ALS, LoweredQualityTiers, BudgetGovernor.GetLoweredTiers(), ECsvCustomStatOp::Set);
+	}
+
+	// Counter stats are cleared every frame
+	SET_FLOAT_STAT(STAT_ALS_BudgetCost, BudgetGovernor.GetCostMs());
+	SET_DWORD_STAT(STAT_ALS_LoweredQualityTiers, BudgetGovernor.GetLoweredTiers());
+	SET_DWORD_STAT(STAT_ALS_QualityTierHigh, NumCharactersPerTier[static_cast<uint8>(EALSQualityTier::High)]);
+	SET_DWORD_STAT(STAT_ALS_QualityTierMedium, NumCharactersPerTier[static_cast<uint8>(EALSQualityTier::Medium)]);
+	SET_DWORD_STAT(STAT_ALS_QualityTierLow, NumCharactersPerTier[static_cast<uint8>(EALSQualityTier::Low)]);
+	SET_DWORD_STAT(STAT_ALS_QualityTierMinimal, NumCharactersPerTier[static_cast<uint8>(EALSQualityTier::Minimal)]);
+}
+
+void UALSCharacterUpdateSubsystem::UpdateAnimSharing(float DeltaTime)
+{
+	ALS_SCOPE_CYCLE_COUNTER(UpdateAnimSharing);
+
+	// Nothing is rendered on a dedicated server
+	const bool bEnabled = CVarAnimSharing.GetValueOnGameThread() != 0 && !IsRunningDedicatedServer();
+
+	// Step 1: Followers that left the state of their leader go back to their own animation right away
+	NumAnimSharingFollowers = 0;
+	for (AALSBaseCharacter* Character : Characters)
+	{
+		const AALSBaseCharacter* Leader = Character->GetAnimSharingLeader();
+		if (!Leader)
+		{
+			continue;
+		}
+
+		if (!bEnabled || !IsValid(Leader) || !Character->CanShareAnimation() || !Leader->CanShareAnimation()
+			|| Character->GetAnimSharingKey() != Leader->GetAnimSharingKey())
+		{
+			Character->SetAnimSharingLeader(nullptr);
+		}
+		else
+		{
+			++NumAnimSharingFollowers;
+		}
+	}
+
+	if (!bEnabled)
+	{
+		AnimSharingLeaders.Reset();
+		AnimSharingTime = 0.0f;
+		return;
+	}
+
+	// Step 2: Regroup the characters at a fixed interval, the groups change slowly
+	AnimSharingTime += DeltaTime;
+	if (AnimSharingTime >= CVarAnimSharingInterval.GetValueOnGameThread())
+	{
+		AnimSharingTime = 0.0f;
+		AssignAnimSharingLeaders();
+	}
+
+	SET_DWORD_STAT(STAT_ALS_AnimSharingLeaders, AnimSharingLeaders.Num());
+	SET_DWORD_STAT(STAT_ALS_AnimSharingFollowers, NumAnimSharingFollowers);
+}
+
+void UALSCharacterUpdateSubsystem::AssignAnimSharingLeaders()
+{
+	// Characters that already share keep sharing until they come a bit closer, so they don't switch back and forth
+	const float StartDistance = CVarAnimSharingDistance.GetValueOnGameThread();
+	const float StopDistance = StartDistance * CVarAnimSharingHysteresis.GetValueOnGameThread();
+	const int32 LeadersPerGroup = FMath::Max(1, CVarAnimSharingLeadersPerGroup.GetValueOnGameThread());
+
+	// Step 1: Group the distant characters that can share their animation by their state
+	TMap<uint32, TArray<AALSBaseCharacter*>> Groups;
+	for (AALSBaseCharacter* Character : Characters)
+	{
+		const bool bSharing = Character->GetAnimSharingLeader() || AnimSharingLeaders.Contains(Character);
+		const float Distance = bSharing ? StopDistance : StartDistance;
+		if (Character->CanShareAnimation() && GetViewDistanceSquared(Character) > FMath::Square(Distance))
+		{
+			Groups.FindOrAdd(Character->GetAnimSharingKey()).Add(Character);
+		}
+		else
+		{
+			Character->SetAnimSharingLeader(nullptr);
+		}
+	}
+
+	// Step 2: Pick the leaders of each group. Current leaders stay leaders and rendered characters are preferred,
+	// their pose is evaluated anyway.
+	const auto GetLeaderPriority = [this](const AALSBaseCharacter& Character)
+	{
+		const bool bRendered = Character.GetMesh()->WasRecentlyRendered(0.2f);
+		return (bRendered ? 0 : 2) + (AnimSharingLeaders.Contains(&Character) ? 0 : 1);
+	};
+
+	TSet<const AALSBaseCharacter*> NewLeaders;
+	NumAnimSharingFollowers = 0;
+	for (TPair<uint32, TArray<AALSBaseCharacter*>>& Group : Groups)
+	{
+		TArray<AALSBaseCharacter*>& Members = Group.Value;
+		if (Members.Num() <= LeadersPerGroup)
+		{
+			// Nobody to share with
+			for (AALSBaseCharacter* Member : Members)
+			{
+				Member->SetAnimSharingLeader(nullptr);
+			}
+			continue;
+		}
+
+		Members.StableSort([&GetLeaderPriority](const AALSBaseCharacter& A, const AALSBaseCharacter& B)
+		{
+			return GetLeaderPriority(A) < GetLeaderPriority(B);
+		});
+
+		for (int32 Index = 0; Index < LeadersPerGroup; ++Index)
+		{
+			Members[Index]->SetAnimSharingLeader(nullptr);
+			NewLeaders.Add(Members[Index]);
+		}
+
+		// Step 3: Spread the other characters over the leaders, followers stay with their leader while it leads
+		for (int32 Index = LeadersPerGroup; Index < Members.Num(); ++Index)
+		{
+			AALSBaseCharacter* Follower = Members[Index];
+			const int32 LeaderIndex = Members.Find(Follower->GetAnimSharingLeader());
+			if (LeaderIndex == INDEX_NONE || LeaderIndex >= LeadersPerGroup)
+			{
+				Follower->SetAnimSharingLeader(Members[Index % LeadersPerGroup]);
+			}
+			++NumAnimSharingFollowers;
+		}
+	}
+
+	AnimSharingLeaders = MoveTemp(NewLeaders);
+}
+
+void UALSCharacterUpdateSubsystem::ReleaseAnimSharingFollowers(const AALSBaseCharacter* Leader)
+{
+	for (AALSBaseCharacter* Character : Characters)
+	{
+		if (Character && Character->GetAnimSharingLeader() == Leader)
+		{
+			Character->SetAnimSharingLeader(nullptr);
+		}
+	}
+}
+
+void UALSCharacterUpdateSubsystem::GatherUpdatedCharacters(float DeltaTime)
+{
+	UpdatedCharacters.Reset(Characters.Num());
+
+	const bool bUpdateLOD = CVarUpdateLOD.GetValueOnGameThread() != 0;
+
+	for (AALSBaseCharacter* Character : Characters)
+	{
+		if (Character->bDormant)
+		{
+			if (!ShouldWakeUp(Character))
+			{
+				continue;
+			}
+
+			// Don't catch up the time spent asleep
+			Character->SetDormant(false);
+			Character->UpdateAccumulatedDeltaTime = 0.0f;
+		}
+
+		// Skipped frames are caught up by updating with the accumulated delta time, so interpolations
+		// still converge to the same values
+		const float DilatedDeltaTime = DeltaTime * Character->CustomTimeDilation;
+		Character->UpdateAccumulatedDeltaTime += DilatedDeltaTime;
+
+		// The accumulated time is dilated, so compare it with the dilated interval and half a dilated frame
+		const float Interval = FMath::Max(bUpdateLOD ? GetUpdateInterval(Character) : 0.0f,
+		                                  Character->GetQualitySettings().UpdateInterval);
+		if (Character->UpdateAccumulatedDeltaTime + DilatedDeltaTime * 0.5f >= Interval * Character->CustomTimeDilation)
+		{
+			UpdatedCharacters.Add(Character);
+		}
+	}
+}
+
+float UALSCharacterUpdateSubsystem::GetViewDistanceSquared(const AALSBaseCharacter* Character) const
+{
+	const FVector CharacterLocation = Character->GetActorLocation();
+	float MinDistanceSquared = BIG_NUMBER;
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared(CharacterLocation, ViewLocation));
+	}
+	return MinDistanceSquared;
+}
+
+float UALSCharacterUpdateSubsystem::GetUpdateInterval(const AALSBaseCharacter* Character) const
+{
+	// Always update characters controlled on this machine at full rate
+	if (Character->IsLocallyControlled())
+	{
+		return 0.0f;
+	}
+
+	const float MinDistanceSquared = GetViewDistanceSquared(Character);
+	const float FarDistance = CVarUpdateLODFarDistance.GetValueOnGameThread();
+	if (MinDistanceSquared > FMath::Square(FarDistance))
+	{
+		return 1.0f / FMath::Max(CVarUpdateLODFarRate.GetValueOnGameThread(), 1.0f);
+	}
+
+	const float MidDistance = CVarUpdateLODMidDistance.GetValueOnGameThread();
+	const bool bRendered = IsRunningDedicatedServer() || Character->GetMesh()->WasRecentlyRendered(0.2f);
+	if (MinDistanceSquared > FMath::Square(MidDistance) || !bRendered)
+	{
+		return 1.0f / FMath::Max(CVarUpdateLODMidRate.GetValueOnGameThread(), 1.0f);
+	}
+
+	return 0.0f;
+}
+
+void UALSCharacterUpdateSubsystem::UpdateDormancy(AALSBaseCharacter* Character, float DeltaTime) const
+{
+	const bool bIdle = Character->MovementState == EALSMovementState::Grounded
+		&& Character->MovementAction == EALSMovementAction::None
+		&& !Character->HasPendingLatches()
+		&& !ShouldWakeUp(Character);
+
+	if (!bIdle || !Character->bCanBecomeDormant || CVarDormancy.GetValueOnGameThread() == 0)
+	{
+		Character->DormancyIdleTime = 0.0f;
+		return;
+	}
+
+	Character->DormancyIdleTime += DeltaTime;
+	if (Character->DormancyIdleTime >= CVarDormancyIdleTime.GetValueOnGameThread())
+	{
+		Character->SetDormant(true);
+	}
+}
+
+bool UALSCharacterUpdateSubsystem::ShouldWakeUp(const AALSBaseCharacter* Character) const
+{
+	// Inputs of simulated proxies arrive through replication
+	const bool bSimulatedProxy = Character->GetLocalRole() == ROLE_SimulatedProxy;
+	const FVector CurrentAcceleration = bSimulatedProxy
+		                                    ? Character->ReplicatedCurrentAcceleration
+		                                    : Character->GetCharacterMovement()->GetCurrentAcceleration();
+	const FRotator ControlRotation = bSimulatedProxy
+		                                 ? Character->ReplicatedControlRotation
+		                                 : Character->GetControlRotation();
+
+	return !Character->GetVelocity().IsNearlyZero()
+		|| !CurrentAcceleration.IsNearlyZero()
+		|| !ControlRotation.Equals(Character->AimingRotation, 0.1f)
+		|| Character->MainAnimInstance->IsAnyMontagePlaying();
+}
+
+void UALSCharacterUpdateSubsystem::GatherHotState()
+{
+	HotState.SetNum(UpdatedCharacters.Num());
+
+	for (int32 Index = 0; Index < UpdatedCharacters.Num(); ++Index)
+	{
+		AALSBaseCharacter* Character = UpdatedCharacters[Index];
+		UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+
+		const bool bSimulatedProxy = Character->GetLocalRole() == ROLE_SimulatedProxy;
+		if (!bSimulatedProxy)
+		{
+			Character->ReplicatedCurrentAcceleration = CharacterMovement->GetCurrentAcceleration();
+			Character->ReplicatedControlRotation = Character->GetControlRotation();
+		}
+
+		HotState.DeltaTime[Index] = Character->UpdateAccumulatedDeltaTime;
+		Character->UpdateAccumulatedDeltaTime = 0.0f;
+		HotState.Velocity[Index] = Character->GetVelocity();
+		HotState.PreviousVelocity[Index] = Character->PreviousVelocity;
+		HotState.CurrentAcceleration[Index] = Character->ReplicatedCurrentAcceleration;
+		HotState.ControlRotation[Index] = Character->ReplicatedControlRotation;
+		HotState.MaxAcceleration[Index] = CharacterMovement->GetMaxAcceleration();
+		HotState.PreviousAimYaw[Index] = Character->PreviousAimYaw;
+		HotState.bSimulatedProxy[Index] = bSimulatedProxy;
+		HotState.bLocallyControlled[Index] = Character->IsLocallyControlled();
+		HotState.MovementState[Index] = Character->MovementState;
+		HotState.AimingRotation[Index] = Character->AimingRotation;
+		HotState.LastVelocityRotation[Index] = Character->LastVelocityRotation;
+		HotState.LastMovementInputRotation[Index] = Character->LastMovementInputRotation;
+		HotState.Acceleration[Index] = Character->Acceleration;
+		HotState.EasedMaxAcceleration[Index] = Character->EasedMaxAcceleration;
+	}
+}
+
+void UALSCharacterUpdateSubsystem::CommitHotState(const int32 Index)
+{
+	AALSBaseCharacter* Character = UpdatedCharacters[Index];
+
+	Character->EasedMaxAcceleration = HotState.EasedMaxAcceleration[Index];
+	Character->AimingRotation = HotState.AimingRotation[Index];
+	Character->LastVelocityRotation = HotState.LastVelocityRotation[Index];
+	Character->LastMovementInputRotation = HotState.LastMovementInputRotation[Index];
+
+	Character->Acceleration = HotState.Acceleration[Index];
+	Character->SetSpeed(HotState.Speed[Index]);
+	Character->SetIsMoving(HotState.bIsMoving[Index]);
+	Character->SetMovementInputAmount(HotState.MovementInputAmount[Index]);
+	Character->SetHasMovementInput(HotState.bHasMovementInput[Index]);
+	Character->SetAimYawRate(HotState.AimYawRate[Index]);
+	Character->MovementDirection = HotState.MovementDirection[Index];
+}
+
+void UALSCharacterUpdateSubsystem::UpdateMantles()
+{
+	MantlingCharacters.Reset();
+	for (AALSBaseCharacter* Character : Characters)
+	{
+		if (IsValid(Character) && Character->bMantleUpdatePending)
+		{
+			Character->bMantleUpdatePending = false;
+			MantlingCharacters.Add(Character);
+		}
+	}
+
+	if (MantlingCharacters.Num() == 0)
+	{
+		return;
+	}
+
+	ALS_SCOPE_CYCLE_COUNTER(UpdateMantles);
+
+	MantleBatch.SetNum(MantlingCharacters.Num());
+
+	for (int32 Index = 0; Index < MantlingCharacters.Num(); ++Index)
+	{
+		AALSBaseCharacter* Character = MantlingCharacters[Index];
+
+		// Step 1: Continually update the mantle target from the stored local transform to follow along with
+		// moving objects
+		Character->MantleTarget = UALSMathLibrary::MantleComponentLocalToWorld(Character->MantleLedgeLS);
+
+		// Step 2: Update the Position and Correction Alphas using the Position/Correction curve set for each Mantle.
+		const FALSMantleParams& MantleParams = Character->MantleParams;
+		const FVector CurveVec = Character->PositionCorrectionCurveTable.GetVectorValue(
+			MantleParams.PositionCorrectionCurve,
+			MantleParams.StartingPosition + Character->MantleTimeline->GetPlaybackPosition());
+
+		// Step 3: Build the transforms to lerp for independent control over the horizontal and vertical blend to
+		// the animated start position, as well as the target position.
+		const FTransform& ActualStartOffset = Character->MantleActualStartOffset;
+		const FTransform& AnimatedStartOffset = Character->MantleAnimatedStartOffset;
+
+		MantleBatch.Target[Index] = Character->MantleTarget;
+		MantleBatch.ActualStartOffset[Index] = ActualStartOffset;
+		MantleBatch.HorizontalTarget[Index] = FTransform(AnimatedStartOffset.GetRotation(),
+		                                                 {
+			                                                 AnimatedStartOffset.GetLocation().X,
+			                                                 AnimatedStartOffset.GetLocation().Y,
+			                                                 ActualStartOffset.GetLocation().Z
+		                                                 },
+		                                                 FVector::OneVector);
+		MantleBatch.VerticalTarget[Index] = FTransform(ActualStartOffset.GetRotation(),
+		                                               {
+			                                               ActualStartOffset.GetLocation().X,
+			                                               ActualStartOffset.GetLocation().Y,
+			                                               AnimatedStartOffset.GetLocation().Z
+		                                               },
+		                                               FVector::OneVector);
+		MantleBatch.PositionAlpha[Index] = CurveVec.X;
+		MantleBatch.XYCorrectionAlpha[Index] = CurveVec.Y;
+		MantleBatch.ZCorrectionAlpha[Index] = CurveVec.Z;
+		MantleBatch.ActualStart[Index] = UALSMathLibrary::TransfromAdd(Character->MantleTarget, ActualStartOffset);
+		MantleBatch.BlendIn[Index] = Character->MantleBlendIn;
+	}
+
+	// Step 4: Blend into the animated horizontal and rotation offset using the Y value of the Position/Correction
+	// Curve, and into the animated vertical offset using the Z value.
+	UALSMathLibrary::LerpTransforms(MantleBatch.ActualStartOffset, MantleBatch.HorizontalTarget,
+	                                MantleBatch.XYCorrectionAlpha, MantleBatch.HorizontalResult);
+	UALSMathLibrary::LerpTransforms(MantleBatch.ActualStartOffset, MantleBatch.VerticalTarget,
+	                                MantleBatch.ZCorrectionAlpha, MantleBatch.VerticalResult);
+
+	for (int32 Index = 0; Index < MantlingCharacters.Num(); ++Index)
+	{
+		const FTransform& HzLerpResult = MantleBatch.HorizontalResult[Index];
+		const FTransform ResultTransform(HzLerpResult.GetRotation(),
+		                                 {
+			                                 HzLerpResult.GetLocation().X, HzLerpResult.GetLocation().Y,
+			                                 MantleBatch.VerticalResult[Index].GetLocation().Z
+		                                 },
+		                                 FVector::OneVector);
+		MantleBatch.CorrectedStart[Index] = UALSMathLibrary::TransfromAdd(MantleBatch.Target[Index],
+		                                                                  ResultTransform);
+	}
+
+	// Step 5: Blend from the currently blending transforms into the final mantle target using the X value of the
+	// Position/Correction Curve.
+	UALSMathLibrary::LerpTransforms(MantleBatch.CorrectedStart, MantleBatch.Target, MantleBatch.PositionAlpha,
+	                                MantleBatch.PositionResult);
+
+	// Step 6: Initial Blend In (controlled in the timeline curve) to allow the actor to blend into the
+	// Position/Correction curve at the midoint. This prevents pops when mantling an object lower than the animated
+	// mantle.
+	UALSMathLibrary::LerpTransforms(MantleBatch.ActualStart, MantleBatch.PositionResult, MantleBatch.BlendIn,
+	                                MantleBatch.LerpedTarget);
+
+	// Step 7: Set the actors location and rotation to the Lerped Target.
+	for (int32 Index = 0; Index < MantlingCharacters.Num(); ++Index)
+	{
+		AALSBaseCharacter* Character = MantlingCharacters[Index];
+		if (IsValid(Character))
+		{
+			const FTransform& LerpedTarget = MantleBatch.LerpedTarget[Index];
+			Character->SetActorLocationAndTargetRotation(LerpedTarget.GetLocation(),
+			                                             LerpedTarget.GetRotation().Rotator());
+		}
+	}
+
+	MantlingCharacters.Reset();
+}
+
+void UALSCharacterUpdateSubsystem::ApplyPlayerMovementInput()
+{
+	ALS_SCOPE_CYCLE_COUNTER(ApplyPlayerMovementInput);
+
+	InputCharacters.Reset();
+	InputForward.Reset();
+	InputRight.Reset();
+
+	for (AALSBaseCharacter* Character : Characters)
+	{
+		if (!IsValid(Character) || !Character->bPlayerMovementInputPending)
+		{
+			continue;
+		}
+
+		if (Character->MovementState == EALSMovementState::Grounded
+			|| Character->MovementState == EALSMovementState::InAir)
+		{
+			InputCharacters.Add(Character);
+			InputForward.Add(Character->PlayerMovementInputAxes.X);
+			InputRight.Add(Character->PlayerMovementInputAxes.Y);
+		}
+
+		Character->PlayerMovementInputAxes = FVector2D::ZeroVector;
+		Character->bPlayerMovementInputPending = false;
+	}
+
+	UALSMathLibrary::FixDiagonalGamepadValues(InputForward, InputRight);
+
+	for (int32 Index = 0; Index < InputCharacters.Num(); ++Index)
+	{
+		// Default camera relative movement behavior
+		AALSBaseCharacter* Character = InputCharacters[Index];
+		const FRotator DirRotator(0.0f, Character->AimingRotation.Yaw, 0.0f);
+		Character->AddMovementInput(UKismetMathLibrary::GetForwardVector(DirRotator), InputForward[Index]);
+		Character->AddMovementInput(UKismetMathLibrary::GetRightVector(DirRotator), InputRight[Index]);
+	}
+
+	InputCharacters.Reset();
+}
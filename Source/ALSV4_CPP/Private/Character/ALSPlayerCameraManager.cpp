@@ -9,10 +9,15 @@
 #include "Character/ALSPlayerCameraManager.h"
 
 
+#include "Library/ALSStats.h"
 #include "Character/ALSBaseCharacter.h"
+#include "Character/ALSCameraBehaviorDataAsset.h"
 #include "Character/Animation/ALSPlayerCameraBehavior.h"
+#include "Library/ALSMathLibrary.h"
 #include "Kismet/KismetMathLibrary.h"
 
+DECLARE_CYCLE_STAT(TEXT("Custom Camera Behavior"), STAT_ALS_CustomCameraBehavior, STATGROUP_ALS);
+
 AALSPlayerCameraManager::AALSPlayerCameraManager()
 {
 	CameraBehavior = CreateDefaultSubobject<USkeletalMeshComponent>(FName(TEXT("CameraBehavior")));
@@ -20,6 +25,18 @@ AALSPlayerCameraManager::AALSPlayerCameraManager()
 	CameraBehavior->bHiddenInGame = true;
 }
 
+void AALSPlayerCameraManager::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Nothing reads the anim graph anymore, don't tick, evaluate and keep the bone buffers of its mesh
+	if (CameraBehaviorData && CameraBehavior)
+	{
+		CameraBehavior->DestroyComponent();
+		CameraBehavior = nullptr;
+	}
+}
+
 void AALSPlayerCameraManager::OnPossess(AALSBaseCharacter* NewCharacter)
 {
 	// Set "Controlled Pawn" when Player Controller Possesses new character. (called from Player Controller)
@@ -27,31 +44,42 @@ void AALSPlayerCameraManager::OnPossess(AALSBaseCharacter* NewCharacter)
 	ControlledCharacter = NewCharacter;
 
 	// Update references in the Camera Behavior AnimBP.
-	UALSPlayerCameraBehavior* CastedBehv = Cast<UALSPlayerCameraBehavior>(CameraBehavior->GetAnimInstance());
+	UALSPlayerCameraBehavior* CastedBehv = CameraBehavior
+		                                       ? Cast<UALSPlayerCameraBehavior>(CameraBehavior->GetAnimInstance())
+		                                       : nullptr;
 	if (CastedBehv)
 	{
 		CastedBehv->PlayerController = GetOwningPlayerController();
 		CastedBehv->ControlledPawn = ControlledCharacter;
+	}
 
+	if (CastedBehv || CameraBehaviorData)
+	{
 		// Initial position
 		const FVector& TPSLoc = ControlledCharacter->GetThirdPersonPivotTarget().GetLocation();
 		SetActorLocation(TPSLoc);
 		SmoothedPivotTarget.SetLocation(TPSLoc);
+		CameraBehaviorEvaluator.Reset();
 	}
 }
 
 float AALSPlayerCameraManager::GetCameraBehaviorParam(FName CurveName) const
 {
-	UAnimInstance* Inst = CameraBehavior->GetAnimInstance();
+	UAnimInstance* Inst = CameraBehavior ? CameraBehavior->GetAnimInstance() : nullptr;
 	if (Inst)
 	{
 		return Inst->GetCurveValue(CurveName);
 	}
-	return 0.0f;
+
+	// Natively evaluated params, by the names of the anim graph curves
+	const float* Param = CameraParams.FindByCurveName(CurveName);
+	return Param ? *Param : 0.0f;
 }
 
 void AALSPlayerCameraManager::UpdateViewTargetInternal(FTViewTarget& OutVT, float DeltaTime)
 {
+	ALS_BENCHMARK_SCOPE(Camera);
+
 	// Partially taken from base class
 
 	if (OutVT.Target)
@@ -73,21 +101,14 @@ FVector AALSPlayerCameraManager::CalculateAxisIndependentLag(FVector CurrentLoca
                                                              FRotator CameraRotation, FVector LagSpeeds,
                                                              float DeltaTime)
 {
-	CameraRotation.Roll = 0.0f;
-	CameraRotation.Pitch = 0.0f;
-	const FVector UnrotatedCurLoc = CameraRotation.UnrotateVector(CurrentLocation);
-	const FVector UnrotatedTargetLoc = CameraRotation.UnrotateVector(TargetLocation);
-
-	const FVector ResultVector(
-		FMath::FInterpTo(UnrotatedCurLoc.X, UnrotatedTargetLoc.X, DeltaTime, LagSpeeds.X),
-		FMath::FInterpTo(UnrotatedCurLoc.Y, UnrotatedTargetLoc.Y, DeltaTime, LagSpeeds.Y),
-		FMath::FInterpTo(UnrotatedCurLoc.Z, UnrotatedTargetLoc.Z, DeltaTime, LagSpeeds.Z));
-
-	return CameraRotation.RotateVector(ResultVector);
+	return UALSMathLibrary::CalculateAxisIndependentLag(CurrentLocation, TargetLocation, CameraRotation, LagSpeeds,
+	                                                    DeltaTime);
 }
 
 bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Location, FRotator& Rotation, float& FOV)
 {
+	ALS_SCOPE_CYCLE_COUNTER(CustomCameraBehavior);
+
 	if (!ControlledCharacter)
 	{
 		return false;
@@ -101,23 +122,37 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 	bool bRightShoulder = false;
 	ControlledCharacter->GetCameraParameters(TPFOV, FPFOV, bRightShoulder);
 
+	// Evaluate the camera behavior natively, or read all camera behavior curves once for this update
+	const UALSPlayerCameraBehavior* Behavior = CameraBehavior
+		                                           ? Cast<UALSPlayerCameraBehavior>(CameraBehavior->GetAnimInstance())
+		                                           : nullptr;
+	if (CameraBehaviorData)
+	{
+		CameraParams = CameraBehaviorEvaluator.Update(*CameraBehaviorData, *ControlledCharacter, bRightShoulder,
+		                                              DeltaTime);
+	}
+	else if (Behavior)
+	{
+		Behavior->GetCameraBehaviorParams(CameraParams);
+	}
+	else
+	{
+		CameraParams = FALSCameraBehaviorParams();
+	}
+
 	// Step 2: Calculate Target Camera Rotation. Use the Control Rotation and interpolate for smooth camera rotation.
 	const FRotator& InterpResult = FMath::RInterpTo(GetCameraRotation(),
 	                                                GetOwningPlayerController()->GetControlRotation(), DeltaTime,
-	                                                GetCameraBehaviorParam(FName(TEXT("RotationLagSpeed"))));
+	                                                CameraParams.RotationLagSpeed);
 
-	TargetCameraRotation = UKismetMathLibrary::RLerp(InterpResult, DebugViewRotation,
-	                                                 GetCameraBehaviorParam(TEXT("Override_Debug")), true);
+	TargetCameraRotation = UKismetMathLibrary::RLerp(InterpResult, DebugViewRotation, CameraParams.OverrideDebug,
+	                                                 true);
 
 	// Step 3: Calculate the Smoothed Pivot Target (Orange Sphere).
 	// Get the 3P Pivot Target (Green Sphere) and interpolate using axis independent lag for maximum control.
-	const FVector LagSpd(GetCameraBehaviorParam(FName(TEXT("PivotLagSpeed_X"))),
-	                     GetCameraBehaviorParam(FName(TEXT("PivotLagSpeed_Y"))),
-	                     GetCameraBehaviorParam(FName(TEXT("PivotLagSpeed_Z"))));
-
 	const FVector& AxisIndpLag = CalculateAxisIndependentLag(SmoothedPivotTarget.GetLocation(),
-	                                                         PivotTarget.GetLocation(), TargetCameraRotation, LagSpd,
-	                                                         DeltaTime);
+	                                                         PivotTarget.GetLocation(), TargetCameraRotation,
+	                                                         CameraParams.PivotLagSpeed, DeltaTime);
 
 	SmoothedPivotTarget.SetRotation(PivotTarget.GetRotation());
 	SmoothedPivotTarget.SetLocation(AxisIndpLag);
@@ -127,23 +162,18 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 	// Pivot Target and apply local offsets for further camera control.
 	PivotLocation =
 		SmoothedPivotTarget.GetLocation() +
-		UKismetMathLibrary::GetForwardVector(SmoothedPivotTarget.Rotator()) * GetCameraBehaviorParam(
-			FName(TEXT("PivotOffset_X"))) +
-		UKismetMathLibrary::GetRightVector(SmoothedPivotTarget.Rotator()) * GetCameraBehaviorParam(
-			FName(TEXT("PivotOffset_Y"))) +
-		UKismetMathLibrary::GetUpVector(SmoothedPivotTarget.Rotator()) * GetCameraBehaviorParam(
-			FName(TEXT("PivotOffset_Z")));
+		UKismetMathLibrary::GetForwardVector(SmoothedPivotTarget.Rotator()) * CameraParams.PivotOffset.X +
+		UKismetMathLibrary::GetRightVector(SmoothedPivotTarget.Rotator()) * CameraParams.PivotOffset.Y +
+		UKismetMathLibrary::GetUpVector(SmoothedPivotTarget.Rotator()) * CameraParams.PivotOffset.Z;
 
 	// Step 5: Calculate Target Camera Location. Get the Pivot location and apply camera relative offsets.
 	TargetCameraLocation = UKismetMathLibrary::VLerp(
 		PivotLocation +
-		UKismetMathLibrary::GetForwardVector(TargetCameraRotation) * GetCameraBehaviorParam(
-			FName(TEXT("CameraOffset_X"))) +
-		UKismetMathLibrary::GetRightVector(TargetCameraRotation) * GetCameraBehaviorParam(FName(TEXT("CameraOffset_Y")))
-		+
-		UKismetMathLibrary::GetUpVector(TargetCameraRotation) * GetCameraBehaviorParam(FName(TEXT("CameraOffset_Z"))),
+		UKismetMathLibrary::GetForwardVector(TargetCameraRotation) * CameraParams.CameraOffset.X +
+		UKismetMathLibrary::GetRightVector(TargetCameraRotation) * CameraParams.CameraOffset.Y +
+		UKismetMathLibrary::GetUpVector(TargetCameraRotation) * CameraParams.CameraOffset.Z,
 		PivotTarget.GetLocation() + DebugViewOffset,
-		GetCameraBehaviorParam(FName(TEXT("Override_Debug"))));
+		CameraParams.OverrideDebug);
 
 	// Step 6: Trace for an object between the camera and character to apply a corrective offset.
 	// Trace origins are set within the Character BP via the Camera Interface.
@@ -159,9 +189,11 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 	Params.AddIgnoredActor(this);
 	Params.AddIgnoredActor(ControlledCharacter);
 
-	FHitResult HitResult;
-	World->SweepSingleByChannel(HitResult, TraceOrigin, TargetCameraLocation, FQuat::Identity,
-	                            TraceChannel, FCollisionShape::MakeSphere(TraceRadius), Params);
+	UALSSceneQuerySubsystem* SceneQueries = World->GetSubsystem<UALSSceneQuerySubsystem>();
+	check(SceneQueries);
+	const FHitResult& HitResult = SceneQueries->SweepSingleByChannel(
+		CameraCollisionQuery, EALSSceneQuerySystem::Camera, TraceOrigin, TargetCameraLocation, TraceChannel,
+		FCollisionShape::MakeSphere(TraceRadius), Params);
 
 	if (HitResult.IsValidBlockingHit())
 	{
@@ -176,18 +208,16 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 	FTransform FPTargetCameraTransform(TargetCameraRotation, FPTarget, FVector::OneVector);
 
 	const FTransform& MixedTransform = UKismetMathLibrary::TLerp(TargetCameraTransform, FPTargetCameraTransform,
-	                                                             GetCameraBehaviorParam(
-		                                                             FName(TEXT("Weight_FirstPerson"))));
+	                                                             CameraParams.WeightFirstPerson);
 
 	const FTransform& TargetTransform = UKismetMathLibrary::TLerp(MixedTransform,
 	                                                              FTransform(DebugViewRotation, TargetCameraLocation,
 	                                                                         FVector::OneVector),
-	                                                              GetCameraBehaviorParam(
-		                                                              FName(TEXT("Override_Debug"))));
+	                                                              CameraParams.OverrideDebug);
 
 	Location = TargetTransform.GetLocation();
 	Rotation = TargetTransform.Rotator();
-	FOV = FMath::Lerp(TPFOV, FPFOV, GetCameraBehaviorParam(FName(TEXT("Weight_FirstPerson"))));
+	FOV = FMath::Lerp(TPFOV, FPFOV, CameraParams.WeightFirstPerson);
 
 	return true;
 }
@@ -0,0 +1,167 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/ALSSceneQuerySubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Library/ALSStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Traces"), STAT_ALS_AsyncTraces, STATGROUP_ALS);
+
+static TAutoConsoleVariable<int32> CVarAsyncSceneQueries(
+	TEXT("ALS.SceneQueries.Async"),
+	1,
+	TEXT("If non zero, scene queries of ALS systems that tolerate latency are issued as async queries."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarFootIKMaxLatency(
+	TEXT("ALS.SceneQueries.FootIK.MaxLatency"),
+	1,
+	TEXT("Number of frames foot IK trace results may lag behind. Zero runs the traces right away."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarRagdollMaxLatency(
+	TEXT("ALS.SceneQueries.Ragdoll.MaxLatency"),
+	1,
+	TEXT("Number of frames ragdoll ground trace results may lag behind. Zero runs the traces right away."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCameraMaxLatency(
+	TEXT("ALS.SceneQueries.Camera.MaxLatency"),
+	0,
+	TEXT("Number of frames camera collision sweep results may lag behind. Zero runs the sweeps right away."),
+	ECVF_Default);
+
+namespace
+{
+	/**
+	 * Picks up the result of the pending async query and decides whether the query runs right away, is issued
+	 * as an async query or keeps using its latest result
+	 */
+	template <typename FRunNow, typename FIssue>
+	const FHitResult& ScheduleQuery(UWorld* World, FALSSceneQuery& Query, int32 MaxLatency, FRunNow RunNow,
+	                                FIssue Issue)
+	{
+		if (MaxLatency > 0)
+		{
+			if (Query.Handle.IsValid() && Query.RequestFrame != GFrameCounter)
+			{
+				// Async results are only available on the frame after the query was issued
+				FTraceDatum Datum;
+				if (World->QueryTraceData(Query.Handle, Datum))
+				{
+					Query.Hit = Datum.OutHits.Num() > 0 ? Datum.OutHits[0] : FHitResult(Datum.Start, Datum.End);
+					Query.ResultFrame = Query.RequestFrame;
+					Query.bHasResult = true;
+				}
+				Query.Handle.Invalidate();
+			}
+
+			if (Query.bHasResult && GFrameCounter - Query.ResultFrame <= static_cast<uint64>(MaxLatency))
+			{
+				if (!Query.Handle.IsValid() && GFrameCounter - Query.RequestFrame >= static_cast<uint64>(MaxLatency))
+				{
+					ALS_SCOPE_TRACE();
+					INC_DWORD_STAT(STAT_ALS_AsyncTraces);
+					Query.Handle = Issue();
+					Query.RequestFrame = GFrameCounter;
+				}
+				return Query.Hit;
+			}
+		}
+
+		// No result recent enough, e.g. on the first query or when the consumer skipped frames
+		{
+			ALS_SCOPE_TRACE();
+			Query.Hit = FHitResult();
+			RunNow(Query.Hit);
+		}
+		Query.Handle.Invalidate();
+		Query.RequestFrame = GFrameCounter;
+		Query.ResultFrame = GFrameCounter;
+		Query.bHasResult = true;
+		return Query.Hit;
+	}
+}
+
+const FHitResult& UALSSceneQuerySubsystem::LineTraceSingleByChannel(FALSSceneQuery& Query,
+                                                                    EALSSceneQuerySystem System,
+                                                                    const FVector& Start, const FVector& End,
+                                                                    ECollisionChannel TraceChannel,
+                                                                    const FCollisionQueryParams& Params)
+{
+	UWorld* World = GetWorld();
+	const auto RunNow = [&](FHitResult& OutHit)
+	{
+		World->LineTraceSingleByChannel(OutHit, Start, End, TraceChannel, Params);
+	};
+	const auto Issue = [&]()
+	{
+		return World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, TraceChannel, Params);
+	};
+	return ScheduleQuery(World, Query, GetMaxLatency(System), RunNow, Issue);
+}
+
+const FHitResult& UALSSceneQuerySubsystem::SweepSingleByChannel(FALSSceneQuery& Query, EALSSceneQuerySystem System,
+                                                                const FVector& Start, const FVector& End,
+                                                                ECollisionChannel TraceChannel,
+                                                                const FCollisionShape& Shape,
+                                                                const FCollisionQueryParams& Params)
+{
+	UWorld* World = GetWorld();
+	const auto RunNow = [&](FHitResult& OutHit)
+	{
+		World->SweepSingleByChannel(OutHit, Start, End, FQuat::Identity, TraceChannel, Shape, Params);
+	};
+	const auto Issue = [&]()
+	{
+		return World->AsyncSweepByChannel(EAsyncTraceType::Single, Start, End, FQuat::Identity, TraceChannel, Shape,
+		                                  Params);
+	};
+	return ScheduleQuery(World, Query, GetMaxLatency(System), RunNow, Issue);
+}
+
+const FHitResult& UALSSceneQuerySubsystem::SweepSingleByProfile(FALSSceneQuery& Query, EALSSceneQuerySystem System,
+                                                                const FVector& Start, const FVector& End,
+                                                                FName ProfileName, const FCollisionShape& Shape,
+                                                                const FCollisionQueryParams& Params)
+{
+	UWorld* World = GetWorld();
+	const auto RunNow = [&](FHitResult& OutHit)
+	{
+		World->SweepSingleByProfile(OutHit, Start, End, FQuat::Identity, ProfileName, Shape, Params);
+	};
+	const auto Issue = [&]()
+	{
+		return World->AsyncSweepByProfile(EAsyncTraceType::Single, Start, End, FQuat::Identity, ProfileName, Shape,
+		                                  Params);
+	};
+	return ScheduleQuery(World, Query, GetMaxLatency(System), RunNow, Issue);
+}
+
+int32 UALSSceneQuerySubsystem::GetMaxLatency(EALSSceneQuerySystem System)
+{
+	if (CVarAsyncSceneQueries.GetValueOnGameThread() == 0)
+	{
+		return 0;
+	}
+
+	switch (System)
+	{
+	case EALSSceneQuerySystem::FootIK:
+		return CVarFootIKMaxLatency.GetValueOnGameThread();
+	case EALSSceneQuerySystem::Ragdoll:
+		return CVarRagdollMaxLatency.GetValueOnGameThread();
+	case EALSSceneQuerySystem::Camera:
+		return CVarCameraMaxLatency.GetValueOnGameThread();
+	default:
+		checkNoEntry();
+		return 0;
+	}
+}
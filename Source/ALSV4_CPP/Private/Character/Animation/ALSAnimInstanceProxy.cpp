@@ -0,0 +1,36 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/Animation/ALSAnimInstanceProxy.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+
+void FALSAnimInstanceProxy::Initialize(UAnimInstance* InAnimInstance)
+{
+	Super::Initialize(InAnimInstance);
+	ALSAnimInstance = Cast<UALSCharacterAnimInstance>(InAnimInstance);
+}
+
+void FALSAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	Super::Update(DeltaSeconds);
+
+	if (ALSAnimInstance)
+	{
+		ALSAnimInstance->ThreadSafeUpdateAnimation(DeltaSeconds);
+	}
+}
+
+void FALSAnimInstanceProxy::PostUpdate(UAnimInstance* InAnimInstance) const
+{
+	Super::PostUpdate(InAnimInstance);
+
+	if (ALSAnimInstance)
+	{
+		ALSAnimInstance->PostThreadSafeUpdateAnimation();
+	}
+}
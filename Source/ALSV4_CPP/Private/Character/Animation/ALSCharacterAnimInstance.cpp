@@ -7,22 +7,89 @@
 
 
 #include "Character/Animation/ALSCharacterAnimInstance.h"
+#include "Character/Animation/ALSAnimInstanceProxy.h"
+#include "Library/ALSStats.h"
 #include "Character/ALSBaseCharacter.h"
-#include "Library/ALSMathLibrary.h"
+#include "Library/ALSLocomotionCore.h"
+#include "Animation/AnimMontage.h"
 #include "Curves/CurveVector.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Anim Update"), STAT_ALS_AnimUpdate, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Thread Safe Anim Update"), STAT_ALS_ThreadSafeAnimUpdate, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Update Foot IK"), STAT_ALS_UpdateFootIK, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Calculate Land Prediction"), STAT_ALS_CalculateLandPrediction, STATGROUP_ALS);
+
+static TAutoConsoleVariable<int32> CVarFootIKLOD(
+	TEXT("ALS.FootIK.LOD"),
+	1,
+	TEXT("If non zero, foot IK of characters that are not controlled by a local player is simplified based on the ")
+	TEXT("predicted mesh LOD, and switched off while the mesh is not rendered."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarFootIKLODFullMaxMeshLOD(
+	TEXT("ALS.FootIK.LOD.FullMaxMeshLOD"),
+	0,
+	TEXT("Highest mesh LOD that traces each foot."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarFootIKLODPlaneMaxMeshLOD(
+	TEXT("ALS.FootIK.LOD.PlaneMaxMeshLOD"),
+	1,
+	TEXT("Highest mesh LOD that places both feet on the floor plane below the pelvis. Foot IK is off above it."),
+	ECVF_Default);
 
 void UALSCharacterAnimInstance::NativeInitializeAnimation()
 {
 	Super::NativeInitializeAnimation();
 	Character = Cast<AALSBaseCharacter>(TryGetPawnOwner());
+	CurveRegistry.Initialize(CurrentSkeleton);
+
+	QueryParams.ClearIgnoredActors();
+	QueryParams.AddIgnoredActor(Character);
+}
+
+void UALSCharacterAnimInstance::NativePostEvaluateAnimation()
+{
+	Super::NativePostEvaluateAnimation();
+
+	// Read all ALS curves once the new values are evaluated
+	if (!CurveRegistry.IsInitializedFor(CurrentSkeleton))
+	{
+		CurveRegistry.Initialize(CurrentSkeleton);
+	}
+	CurveRegistry.ReadCurveValues(*this, CurveValues);
+}
+
+void UALSCharacterAnimInstance::PublishCharacterInformation(const FALSAnimCharacterInformation& NewCharacterInformation)
+{
+	PublishedCharacterInformation = NewCharacterInformation;
+}
+
+FAnimInstanceProxy* UALSCharacterAnimInstance::CreateAnimInstanceProxy()
+{
+	return new FALSAnimInstanceProxy(this);
 }
 
 void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
+	ALS_BENCHMARK_SCOPE(AnimUpdate);
+	ALS_SCOPE_CYCLE_COUNTER(AnimUpdate);
+
 	Super::NativeUpdateAnimation(DeltaSeconds);
 
+	UpdateLatches();
+
+	if (SharedPoseBlendAlpha > 0.0f)
+	{
+		SharedPoseBlendAlpha = FMath::FInterpConstantTo(SharedPoseBlendAlpha, 0.0f, DeltaSeconds,
+		                                                1.0f / FMath::Max(Config.SharedPoseBlendOutTime, 0.01f));
+	}
+
+	bRunThreadSafeUpdate = false;
+
 	if (!Character || DeltaSeconds == 0.0f)
 	{
 		// Fix character looking right on editor
@@ -32,15 +99,51 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 		return;
 	}
 
-	// Update rest of character information. Others are reflected into anim bp when they're set inside character class
-	CharacterInformation.Velocity = Character->GetCharacterMovement()->Velocity;
-	CharacterInformation.MovementInput = Character->GetMovementInput();
-	CharacterInformation.AimingRotation = Character->GetAimingRotation();
-	CharacterInformation.CharacterActorRotation = Character->GetActorRotation();
+	// Take the character information last published by the character, the anim update reads no other character state
+	CharacterInformation = PublishedCharacterInformation;
+
+	// Gather the values the thread safe update needs from the mesh
+	MeshScaleZ = GetOwningComponent()->GetComponentScale().Z;
+	bRunThreadSafeUpdate = true;
+
+	// World queries, bone reads and montages stay on the game thread
+	UpdateFootIK(DeltaSeconds);
+
+	if (MovementState.Grounded())
+	{
+		if (!ShouldMoveCheck() && CanDynamicTransition() && CharacterInformation.bDynamicTransitions)
+		{
+			DynamicTransitionCheck();
+		}
+	}
+	else if (MovementState.InAir())
+	{
+		// Update the fall speed. Setting this value only while in the air allows you to use it within the AnimGraph for the landing strength.
+		// If not, the Z velocity would return to 0 on landing.
+		InAir.FallSpeed = CharacterInformation.Velocity.Z;
+
+		// Set the Land Prediction weight.
+		InAir.LandPrediction = CalculateLandPrediction();
+	}
+	else if (MovementState.Ragdoll())
+	{
+		// Do While Ragdolling
+		UpdateRagdollValues();
+	}
+}
+
+void UALSCharacterAnimInstance::ThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	ALS_BENCHMARK_SCOPE(AnimUpdate);
+	ALS_SCOPE_CYCLE_COUNTER(ThreadSafeAnimUpdate);
+
+	if (!bRunThreadSafeUpdate)
+	{
+		return;
+	}
 
 	UpdateAimingValues(DeltaSeconds);
 	UpdateLayerValues();
-	UpdateFootIK(DeltaSeconds);
 
 	if (MovementState.Grounded())
 	{
@@ -82,10 +185,6 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 			{
 				TurnInPlaceValues.ElapsedDelayTime = 0.0f;
 			}
-			if (CanDynamicTransition())
-			{
-				DynamicTransitionCheck();
-			}
 		}
 	}
 	else if (MovementState.InAir())
@@ -93,18 +192,25 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 		// Do While InAir
 		UpdateInAirValues(DeltaSeconds);
 	}
-	else if (MovementState.Ragdoll())
+}
+
+void UALSCharacterAnimInstance::PostThreadSafeUpdateAnimation()
+{
+	if (bPendingTurnInPlace)
 	{
-		// Do While Ragdolling
-		UpdateRagdollValues();
+		bPendingTurnInPlace = false;
+
+		FRotator TurnInPlaceYawRot = CharacterInformation.AimingRotation;
+		TurnInPlaceYawRot.Roll = 0.0f;
+		TurnInPlaceYawRot.Pitch = 0.0f;
+		TurnInPlace(TurnInPlaceYawRot, 1.0f, 0.0f, false);
 	}
 }
 
 void UALSCharacterAnimInstance::PlayTransition(const FALSDynamicMontageParams& Parameters)
 {
-	PlaySlotAnimationAsDynamicMontage(Parameters.Animation, FName(TEXT("Grounded Slot")),
-	                                  Parameters.BlendInTime, Parameters.BlendOutTime, Parameters.PlayRate, 1,
-	                                  0.0f, Parameters.StartTime);
+	PlayPooledSlotAnimation(Parameters.Animation, FName(TEXT("Grounded Slot")), Parameters.BlendInTime,
+	                        Parameters.BlendOutTime, Parameters.PlayRate, Parameters.StartTime);
 }
 
 void UALSCharacterAnimInstance::PlayTransitionChecked(const FALSDynamicMontageParams& Parameters)
@@ -126,9 +232,7 @@ void UALSCharacterAnimInstance::PlayDynamicTransition(float ReTriggerDelay, FALS
 
 		UWorld* World = GetWorld();
 		check(World);
-		World->GetTimerManager().SetTimer(PlayDynamicTransitionTimer, this,
-		                                  &UALSCharacterAnimInstance::PlayDynamicTransitionDelay,
-		                                  ReTriggerDelay, false);
+		PlayDynamicTransitionLatch.Set(World->GetTimeSeconds(), ReTriggerDelay);
 	}
 }
 
@@ -148,12 +252,32 @@ bool UALSCharacterAnimInstance::CanTurnInPlace() const
 {
 	return RotationMode.LookingDirection() &&
 		CharacterInformation.ViewMode == EALSViewMode::ThirdPerson &&
-		GetCurveValue(FName(TEXT("Enable_Transition"))) > 0.99f;
+		CurveValues.Get(EALSAnimCurve::Enable_Transition) > 0.99f;
 }
 
 bool UALSCharacterAnimInstance::CanDynamicTransition() const
 {
-	return GetCurveValue(FName(TEXT("Enable_Transition"))) == 1.0f;
+	return CurveValues.Get(EALSAnimCurve::Enable_Transition) == 1.0f;
+}
+
+void UALSCharacterAnimInstance::UpdateLatches()
+{
+	UWorld* World = GetWorld();
+	check(World);
+	const float Time = World->GetTimeSeconds();
+
+	if (PlayDynamicTransitionLatch.Poll(Time))
+	{
+		PlayDynamicTransitionDelay();
+	}
+	if (OnJumpedLatch.Poll(Time))
+	{
+		OnJumpedDelay();
+	}
+	if (OnPivotLatch.Poll(Time))
+	{
+		OnPivotDelay();
+	}
 }
 
 void UALSCharacterAnimInstance::PlayDynamicTransitionDelay()
@@ -231,42 +355,55 @@ void UALSCharacterAnimInstance::UpdateAimingValues(float DeltaSeconds)
 void UALSCharacterAnimInstance::UpdateLayerValues()
 {
 	// Get the Aim Offset weight by getting the opposite of the Aim Offset Mask.
-	LayerBlendingValues.EnableAimOffset = FMath::Lerp(1.0f, 0.0f, GetCurveValue(FName(TEXT("Mask_AimOffset"))));
+	LayerBlendingValues.EnableAimOffset = FMath::Lerp(1.0f, 0.0f, CurveValues.Get(EALSAnimCurve::Mask_AimOffset));
 	// Set the Base Pose weights
-	LayerBlendingValues.BasePose_N = GetCurveValue(FName(TEXT("BasePose_N")));
-	LayerBlendingValues.BasePose_CLF = GetCurveValue(FName(TEXT("BasePose_CLF")));
+	LayerBlendingValues.BasePose_N = CurveValues.Get(EALSAnimCurve::BasePose_N);
+	LayerBlendingValues.BasePose_CLF = CurveValues.Get(EALSAnimCurve::BasePose_CLF);
 	// Set the Additive amount weights for each body part
-	LayerBlendingValues.Spine_Add = GetCurveValue(FName(TEXT("Layering_Spine_Add")));
-	LayerBlendingValues.Head_Add = GetCurveValue(FName(TEXT("Layering_Head_Add")));
-	LayerBlendingValues.Arm_L_Add = GetCurveValue(FName(TEXT("Layering_Arm_L_Add")));
-	LayerBlendingValues.Arm_R_Add = GetCurveValue(FName(TEXT("Layering_Arm_R_Add")));
+	LayerBlendingValues.Spine_Add = CurveValues.Get(EALSAnimCurve::Layering_Spine_Add);
+	LayerBlendingValues.Head_Add = CurveValues.Get(EALSAnimCurve::Layering_Head_Add);
+	LayerBlendingValues.Arm_L_Add = CurveValues.Get(EALSAnimCurve::Layering_Arm_L_Add);
+	LayerBlendingValues.Arm_R_Add = CurveValues.Get(EALSAnimCurve::Layering_Arm_R_Add);
 	// Set the Hand Override weights
-	LayerBlendingValues.Hand_R = GetCurveValue(FName(TEXT("Layering_Hand_R")));
-	LayerBlendingValues.Hand_L = GetCurveValue(FName(TEXT("Layering_Hand_L")));
+	LayerBlendingValues.Hand_R = CurveValues.Get(EALSAnimCurve::Layering_Hand_R);
+	LayerBlendingValues.Hand_L = CurveValues.Get(EALSAnimCurve::Layering_Hand_L);
 	// Blend and set the Hand IK weights to ensure they only are weighted if allowed by the Arm layers.
-	LayerBlendingValues.EnableHandIK_L = FMath::Lerp(0.0f, GetCurveValue(FName(TEXT("Enable_HandIK_L"))),
-	                                                 GetCurveValue(FName(TEXT("Layering_Arm_L"))));
-	LayerBlendingValues.EnableHandIK_R = FMath::Lerp(0.0f, GetCurveValue(FName(TEXT("Enable_HandIK_R"))),
-	                                                 GetCurveValue(FName(TEXT("Layering_Arm_R"))));
+	LayerBlendingValues.EnableHandIK_L = FMath::Lerp(0.0f, CurveValues.Get(EALSAnimCurve::Enable_HandIK_L),
+	                                                 CurveValues.Get(EALSAnimCurve::Layering_Arm_L));
+	LayerBlendingValues.EnableHandIK_R = FMath::Lerp(0.0f, CurveValues.Get(EALSAnimCurve::Enable_HandIK_R),
+	                                                 CurveValues.Get(EALSAnimCurve::Layering_Arm_R));
 	// Set whether the arms should blend in mesh space or local space.
 	// The Mesh space weight will always be 1 unless the Local Space (LS) curve is fully weighted.
-	LayerBlendingValues.Arm_L_LS = GetCurveValue(FName(TEXT("Layering_Arm_L_LS")));
+	LayerBlendingValues.Arm_L_LS = CurveValues.Get(EALSAnimCurve::Layering_Arm_L_LS);
 	LayerBlendingValues.Arm_L_MS = static_cast<float>(1 - FMath::FloorToInt(LayerBlendingValues.Arm_L_LS));
-	LayerBlendingValues.Arm_R_LS = GetCurveValue(FName(TEXT("Layering_Arm_R_LS")));
+	LayerBlendingValues.Arm_R_LS = CurveValues.Get(EALSAnimCurve::Layering_Arm_R_LS);
 	LayerBlendingValues.Arm_R_MS = static_cast<float>(1 - FMath::FloorToInt(LayerBlendingValues.Arm_R_LS));
 }
 
 void UALSCharacterAnimInstance::UpdateFootIK(float DeltaSeconds)
 {
+	ALS_SCOPE_CYCLE_COUNTER(UpdateFootIK);
+
+	FootIKLOD = CalculateFootIKLOD();
+	if (FootIKLOD == EALSFootIKLOD::Off)
+	{
+		// Skip the traces and blend all IK values out
+		ResetFootLocking(DeltaSeconds);
+		FootIKValues.PelvisOffset = FMath::VInterpTo(FootIKValues.PelvisOffset, FVector::ZeroVector,
+		                                             DeltaSeconds, 15.0f);
+		ResetIKOffsets(DeltaSeconds);
+		return;
+	}
+
 	FVector FootOffsetLTarget = FVector::ZeroVector;
 	FVector FootOffsetRTarget = FVector::ZeroVector;
 
 	// Update Foot Locking values.
-	SetFootLocking(DeltaSeconds, FName(TEXT("Enable_FootIK_L")), FName(TEXT("FootLock_L")),
-	               FName(TEXT("ik_foot_l")), FootIKValues.FootLock_L_Alpha, FootIKValues.UseFootLockCurve_L,
+	SetFootLocking(DeltaSeconds, EALSAnimCurve::Enable_FootIK_L, EALSAnimCurve::FootLock_L,
+	               EALSBoneSocket::IK_Foot_L, FootIKValues.FootLock_L_Alpha, FootIKValues.UseFootLockCurve_L,
 	               FootIKValues.FootLock_L_Location, FootIKValues.FootLock_L_Rotation);
-	SetFootLocking(DeltaSeconds, FName(TEXT("Enable_FootIK_R")), FName(TEXT("FootLock_R")),
-	               FName(TEXT("ik_foot_r")), FootIKValues.FootLock_R_Alpha, FootIKValues.UseFootLockCurve_R,
+	SetFootLocking(DeltaSeconds, EALSAnimCurve::Enable_FootIK_R, EALSAnimCurve::FootLock_R,
+	               EALSBoneSocket::IK_Foot_R, FootIKValues.FootLock_R_Alpha, FootIKValues.UseFootLockCurve_R,
 	               FootIKValues.FootLock_R_Location, FootIKValues.FootLock_R_Rotation);
 
 	if (MovementState.InAir())
@@ -277,22 +414,36 @@ void UALSCharacterAnimInstance::UpdateFootIK(float DeltaSeconds)
 	}
 	else if (!MovementState.Ragdoll())
 	{
+		if (FootIKLOD == EALSFootIKLOD::Plane && (CurveValues.Get(EALSAnimCurve::Enable_FootIK_L) > 0.0f ||
+			CurveValues.Get(EALSAnimCurve::Enable_FootIK_R) > 0.0f))
+		{
+			// A single trace below the pelvis is shared by both feet
+			const USkeletalMeshComponent* OwnerComp = GetOwningComponent();
+			FVector PelvisFloorLoc = BoneCache.GetSocketLocation(OwnerComp, EALSBoneSocket::Pelvis);
+			PelvisFloorLoc.Z = BoneCache.GetSocketLocation(OwnerComp, EALSBoneSocket::Root).Z;
+			if (!FootIKTraceCache_Pelvis.CanReuse(PelvisFloorLoc))
+			{
+				TraceFootIKFloor(FootIKQuery_Pelvis, FootIKTraceCache_Pelvis, PelvisFloorLoc);
+			}
+		}
+
 		// Update all Foot Lock and Foot Offset values when not In Air
-		SetFootOffsets(DeltaSeconds, FName(TEXT("Enable_FootIK_L")), FName(TEXT("ik_foot_l")), FName(TEXT("root")),
-		               FootOffsetLTarget,
+		SetFootOffsets(DeltaSeconds, EALSAnimCurve::Enable_FootIK_L, EALSBoneSocket::IK_Foot_L,
+		               EALSBoneSocket::Root, FootOffsetLTarget,
 		               FootIKValues.FootOffset_L_Location, FootIKValues.FootOffset_L_Rotation);
-		SetFootOffsets(DeltaSeconds, FName(TEXT("Enable_FootIK_R")), FName(TEXT("ik_foot_r")), FName(TEXT("root")),
-		               FootOffsetRTarget,
+		SetFootOffsets(DeltaSeconds, EALSAnimCurve::Enable_FootIK_R, EALSBoneSocket::IK_Foot_R,
+		               EALSBoneSocket::Root, FootOffsetRTarget,
 		               FootIKValues.FootOffset_R_Location, FootIKValues.FootOffset_R_Rotation);
 		SetPelvisIKOffset(DeltaSeconds, FootOffsetLTarget, FootOffsetRTarget);
 	}
 }
 
-void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, FName EnableFootIKCurve, FName FootLockCurve,
-                                               FName IKFootBone, float& CurFootLockAlpha, bool& UseFootLockCurve,
+void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, EALSAnimCurve EnableFootIKCurve,
+                                               EALSAnimCurve FootLockCurve, EALSBoneSocket IKFootBone,
+                                               float& CurFootLockAlpha, bool& UseFootLockCurve,
                                                FVector& CurFootLockLoc, FRotator& CurFootLockRot)
 {
-	if (GetCurveValue(EnableFootIKCurve) <= 0.0f)
+	if (CurveValues.Get(EnableFootIKCurve) <= 0.0f)
 	{
 		return;
 	}
@@ -302,13 +453,13 @@ void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, FName EnableF
 
 	if (UseFootLockCurve)
 	{
-		UseFootLockCurve = FMath::Abs(GetCurveValue(FName(TEXT("RotationAmount")))) <= 0.001f ||
-			Character->GetLocalRole() != ROLE_AutonomousProxy;
-		FootLockCurveVal = GetCurveValue(FootLockCurve);
+		UseFootLockCurve = FMath::Abs(CurveValues.Get(EALSAnimCurve::RotationAmount)) <= 0.001f ||
+			!CharacterInformation.bAutonomousProxy;
+		FootLockCurveVal = CurveValues.Get(FootLockCurve);
 	}
 	else
 	{
-		UseFootLockCurve = GetCurveValue(FootLockCurve) >= 0.99f;
+		UseFootLockCurve = CurveValues.Get(FootLockCurve) >= 0.99f;
 		FootLockCurveVal = 0.0f;
 	}
 
@@ -316,6 +467,12 @@ void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, FName EnableF
 	// so that the foot can only blend out of the locked position or lock to a new position, and never blend in.
 	if (FootLockCurveVal >= 0.99f || FootLockCurveVal < CurFootLockAlpha)
 	{
+		// The foot starts moving once the lock releases, trace it again
+		if (CurFootLockAlpha >= 0.99f && FootLockCurveVal < 0.99f)
+		{
+			GetFootIKTraceCache(IKFootBone).Invalidate();
+		}
+
 		CurFootLockAlpha = FootLockCurveVal;
 	}
 
@@ -323,7 +480,7 @@ void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, FName EnableF
 	if (CurFootLockAlpha >= 0.99f)
 	{
 		const FTransform& OwnerTransform =
-			GetOwningComponent()->GetSocketTransform(IKFootBone, RTS_Component);
+			BoneCache.GetSocketTransform(GetOwningComponent(), IKFootBone, RTS_Component);
 		CurFootLockLoc = OwnerTransform.GetLocation();
 		CurFootLockRot = OwnerTransform.Rotator();
 	}
@@ -341,10 +498,9 @@ void UALSCharacterAnimInstance::SetFootLockOffsets(float DeltaSeconds, FVector&
 	FRotator RotationDifference = FRotator::ZeroRotator;
 	// Use the delta between the current and last updated rotation to find how much the foot should be rotated
 	// to remain planted on the ground.
-	if (Character->GetCharacterMovement()->IsMovingOnGround())
+	if (CharacterInformation.bIsMovingOnGround)
 	{
-		RotationDifference = CharacterInformation.CharacterActorRotation - Character->GetCharacterMovement()->
-			GetLastUpdateRotation();
+		RotationDifference = CharacterInformation.CharacterActorRotation - CharacterInformation.LastUpdateRotation;
 		RotationDifference.Normalize();
 	}
 
@@ -368,7 +524,7 @@ void UALSCharacterAnimInstance::SetPelvisIKOffset(float DeltaSeconds, FVector Fo
 {
 	// Calculate the Pelvis Alpha by finding the average Foot IK weight. If the alpha is 0, clear the offset.
 	FootIKValues.PelvisAlpha =
-		(GetCurveValue(FName(TEXT("Enable_FootIK_L"))) + GetCurveValue(FName(TEXT("Enable_FootIK_R")))) / 2.0f;
+		(CurveValues.Get(EALSAnimCurve::Enable_FootIK_L) + CurveValues.Get(EALSAnimCurve::Enable_FootIK_R)) / 2.0f;
 
 	if (FootIKValues.PelvisAlpha > 0.0f)
 	{
@@ -400,12 +556,92 @@ void UALSCharacterAnimInstance::ResetIKOffsets(float DeltaSeconds)
 	                                                      FRotator::ZeroRotator, DeltaSeconds, 15.0f);
 }
 
-void UALSCharacterAnimInstance::SetFootOffsets(float DeltaSeconds, FName EnableFootIKCurve, FName IKFootBone,
-                                               FName RootBone, FVector& CurLocationTarget, FVector& CurLocationOffset,
+void UALSCharacterAnimInstance::ResetFootLocking(float DeltaSeconds)
+{
+	// Release the foot locks, keeping the locked feet planted while they blend out
+	FootIKValues.FootLock_L_Alpha = FMath::FInterpTo(FootIKValues.FootLock_L_Alpha, 0.0f, DeltaSeconds, 15.0f);
+	FootIKValues.FootLock_R_Alpha = FMath::FInterpTo(FootIKValues.FootLock_R_Alpha, 0.0f, DeltaSeconds, 15.0f);
+
+	if (FootIKValues.FootLock_L_Alpha > 0.0f)
+	{
+		SetFootLockOffsets(DeltaSeconds, FootIKValues.FootLock_L_Location, FootIKValues.FootLock_L_Rotation);
+	}
+	if (FootIKValues.FootLock_R_Alpha > 0.0f)
+	{
+		SetFootLockOffsets(DeltaSeconds, FootIKValues.FootLock_R_Location, FootIKValues.FootLock_R_Rotation);
+	}
+}
+
+EALSFootIKLOD UALSCharacterAnimInstance::CalculateFootIKLOD() const
+{
+	// The player always sees their own feet in full detail
+	if (CharacterInformation.bLocallyControlledPlayer)
+	{
+		return EALSFootIKLOD::Full;
+	}
+
+	// The quality tier of the character limits the detail
+	if (!CharacterInformation.bFootIK)
+	{
+		return EALSFootIKLOD::Off;
+	}
+
+	const EALSFootIKLOD MaxLOD = CharacterInformation.bFullFootIK ? EALSFootIKLOD::Full : EALSFootIKLOD::Plane;
+	if (CVarFootIKLOD.GetValueOnGameThread() == 0)
+	{
+		return MaxLOD;
+	}
+
+	const USkeletalMeshComponent* OwnerComp = GetOwningComponent();
+	if (!OwnerComp->WasRecentlyRendered(0.2f))
+	{
+		return EALSFootIKLOD::Off;
+	}
+
+	// The predicted mesh LOD follows the screen size of the character
+	const int32 MeshLOD = OwnerComp->GetPredictedLODLevel();
+	if (MeshLOD <= CVarFootIKLODFullMaxMeshLOD.GetValueOnGameThread())
+	{
+		return MaxLOD;
+	}
+	if (MeshLOD <= CVarFootIKLODPlaneMaxMeshLOD.GetValueOnGameThread())
+	{
+		return EALSFootIKLOD::Plane;
+	}
+	return EALSFootIKLOD::Off;
+}
+
+FALSFootIKTraceCache& UALSCharacterAnimInstance::GetFootIKTraceCache(EALSBoneSocket IKFootBone)
+{
+	return IKFootBone == EALSBoneSocket::IK_Foot_L ? FootIKTraceCache_L : FootIKTraceCache_R;
+}
+
+void UALSCharacterAnimInstance::TraceFootIKFloor(FALSSceneQuery& Query, FALSFootIKTraceCache& TraceCache,
+                                                 const FVector& FloorLocation)
+{
+	UWorld* World = GetWorld();
+	check(World);
+	UALSSceneQuerySubsystem* SceneQueries = World->GetSubsystem<UALSSceneQuerySubsystem>();
+	check(SceneQueries);
+
+	const FHitResult& HitResult = SceneQueries->LineTraceSingleByChannel(
+		Query, EALSSceneQuerySystem::FootIK,
+		FloorLocation + FVector(0.0, 0.0, Config.IK_TraceDistanceAboveFoot),
+		FloorLocation - FVector(0.0, 0.0, Config.IK_TraceDistanceBelowFoot),
+		ECC_Visibility, QueryParams);
+
+	// The result can be from an earlier frame, keep the floor location the trace was issued from
+	TraceCache.Store(HitResult, Character->GetCharacterMovement()->IsWalkable(HitResult),
+	                 HitResult.TraceStart - FVector(0.0, 0.0, Config.IK_TraceDistanceAboveFoot));
+}
+
+void UALSCharacterAnimInstance::SetFootOffsets(float DeltaSeconds, EALSAnimCurve EnableFootIKCurve,
+                                               EALSBoneSocket IKFootBone, EALSBoneSocket RootBone,
+                                               FVector& CurLocationTarget, FVector& CurLocationOffset,
                                                FRotator& CurRotationOffset)
 {
 	// Only update Foot IK offset values if the Foot IK curve has a weight. If it equals 0, clear the offset values.
-	if (GetCurveValue(EnableFootIKCurve) <= 0)
+	if (CurveValues.Get(EnableFootIKCurve) <= 0)
 	{
 		CurLocationOffset = FVector::ZeroVector;
 		CurRotationOffset = FRotator::ZeroRotator;
@@ -415,27 +651,39 @@ void UALSCharacterAnimInstance::SetFootOffsets(float DeltaSeconds, FName EnableF
 	// Step 1: Trace downward from the foot location to find the geometry.
 	// If the surface is walkable, save the Impact Location and Normal.
 	USkeletalMeshComponent* OwnerComp = GetOwningComponent();
-	FVector IKFootFloorLoc = OwnerComp->GetSocketLocation(IKFootBone);
-	IKFootFloorLoc.Z = OwnerComp->GetSocketLocation(RootBone).Z;
+	FVector IKFootFloorLoc = BoneCache.GetSocketLocation(OwnerComp, IKFootBone);
+	IKFootFloorLoc.Z = BoneCache.GetSocketLocation(OwnerComp, RootBone).Z;
 
-	UWorld* World = GetWorld();
-	check(World);
-
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(Character);
+	bool bWalkableHit;
+	FVector ImpactPoint;
+	FVector ImpactNormal;
+	if (FootIKLOD == EALSFootIKLOD::Plane)
+	{
+		// Place the foot on the floor plane found below the pelvis
+		bWalkableHit = FootIKTraceCache_Pelvis.bValid;
+		ImpactNormal = FootIKTraceCache_Pelvis.ImpactNormal;
+		ImpactPoint = FMath::LinePlaneIntersection(IKFootFloorLoc, IKFootFloorLoc + FVector::UpVector,
+		                                           FootIKTraceCache_Pelvis.ImpactPoint, ImpactNormal);
+	}
+	else
+	{
+		// Reuse the last walkable hit while the foot and the surface below it don't move
+		FALSFootIKTraceCache& TraceCache = GetFootIKTraceCache(IKFootBone);
+		if (!TraceCache.CanReuse(IKFootFloorLoc))
+		{
+			TraceFootIKFloor(IKFootBone == EALSBoneSocket::IK_Foot_L ? FootIKQuery_L : FootIKQuery_R, TraceCache,
+			                 IKFootFloorLoc);
+		}
 
-	FHitResult HitResult;
-	World->LineTraceSingleByChannel(HitResult,
-	                                IKFootFloorLoc + FVector(0.0, 0.0, Config.IK_TraceDistanceAboveFoot),
-	                                IKFootFloorLoc - FVector(0.0, 0.0, Config.IK_TraceDistanceBelowFoot),
-	                                ECC_Visibility, Params);
+		bWalkableHit = TraceCache.bValid;
+		ImpactPoint = TraceCache.ImpactPoint;
+		ImpactNormal = TraceCache.ImpactNormal;
+		IKFootFloorLoc = TraceCache.FloorLocation;
+	}
 
 	FRotator TargetRotOffset = FRotator::ZeroRotator;
-	if (Character->GetCharacterMovement()->IsWalkable(HitResult))
+	if (bWalkableHit)
 	{
-		FVector ImpactPoint = HitResult.ImpactPoint;
-		FVector ImpactNormal = HitResult.ImpactNormal;
-
 		// Step 1.1: Find the difference in location from the Impact point and the expected (flat) floor location.
 		// These values are offset by the nomrmal multiplied by the
 		// foot height to get better behavior on angled surfaces.
@@ -458,48 +706,17 @@ void UALSCharacterAnimInstance::SetFootOffsets(float DeltaSeconds, FName EnableF
 
 void UALSCharacterAnimInstance::RotateInPlaceCheck()
 {
-	// Step 1: Check if the character should rotate left or right by checking if the Aiming Angle exceeds the threshold.
-	Grounded.bRotateL = AimingValues.AimingAngle.X < RotateInPlace.RotateMinThreshold;
-	Grounded.bRotateR = AimingValues.AimingAngle.X > RotateInPlace.RotateMaxThreshold;
-
-	// Step 2: If the character should be rotating, set the Rotate Rate to scale with the Aim Yaw Rate.
-	// This makes the character rotate faster when moving the camera faster.
-	if (Grounded.bRotateL || Grounded.bRotateR)
-	{
-		Grounded.RotateRate = FMath::GetMappedRangeValueClamped(
-			{RotateInPlace.AimYawRateMinRange, RotateInPlace.AimYawRateMaxRange},
-			{RotateInPlace.MinPlayRate, RotateInPlace.MaxPlayRate},
-			CharacterInformation.AimYawRate);
-	}
+	FALSLocomotionCore::RotateInPlaceCheck(AimingValues.AimingAngle.X, CharacterInformation.AimYawRate, RotateInPlace,
+	                                       Grounded);
 }
 
 void UALSCharacterAnimInstance::TurnInPlaceCheck(float DeltaSeconds)
 {
-	// Step 1: Check if Aiming angle is outside of the Turn Check Min Angle, and if the Aim Yaw Rate is below the Aim Yaw Rate Limit.
-	// If so, begin counting the Elapsed Delay Time. If not, reset the Elapsed Delay Time.
-	// This ensures the conditions remain true for a sustained peroid of time before turning in place.
-	if (FMath::Abs(AimingValues.AimingAngle.X) <= TurnInPlaceValues.TurnCheckMinAngle ||
-		CharacterInformation.AimYawRate >= TurnInPlaceValues.AimYawRateLimit)
+	// The turn montage is played on the game thread once the update is done
+	if (FALSLocomotionCore::TurnInPlaceCheck(AimingValues.AimingAngle.X, CharacterInformation.AimYawRate,
+	                                         DeltaSeconds, TurnInPlaceValues))
 	{
-		TurnInPlaceValues.ElapsedDelayTime = 0.0f;
-		return;
-	}
-
-	TurnInPlaceValues.ElapsedDelayTime += DeltaSeconds;
-	const float ClampedAimAngle = FMath::GetMappedRangeValueClamped({TurnInPlaceValues.TurnCheckMinAngle, 180.0f},
-	                                                                {
-		                                                                TurnInPlaceValues.MinAngleDelay,
-		                                                                TurnInPlaceValues.MaxAngleDelay
-	                                                                },
-	                                                                AimingValues.AimingAngle.X);
-
-	// Step 2: Check if the Elapsed Delay time exceeds the set delay (mapped to the turn angle range). If so, trigger a Turn In Place.
-	if (TurnInPlaceValues.ElapsedDelayTime > ClampedAimAngle)
-	{
-		FRotator TurnInPlaceYawRot = CharacterInformation.AimingRotation;
-		TurnInPlaceYawRot.Roll = 0.0f;
-		TurnInPlaceYawRot.Pitch = 0.0f;
-		TurnInPlace(TurnInPlaceYawRot, 1.0f, 0.0f, false);
+		bPendingTurnInPlace = true;
 	}
 }
 
@@ -509,9 +726,10 @@ void UALSCharacterAnimInstance::DynamicTransitionCheck()
 	// (determined via a virtual bone) exceeds a threshold. If it does, play an additive transition animation on that foot.
 	// The currently set transition plays the second half of a 2 foot transition animation, so that only a single foot moves.
 	// Because only the IK_Foot bone can be locked, the separate virtual bone allows the system to know its desired location when locked.
-	FTransform SocketTransformA = GetOwningComponent()->GetSocketTransform(FName(TEXT("ik_foot_l")), RTS_Component);
-	FTransform SocketTransformB = GetOwningComponent()->GetSocketTransform(
-		FName(TEXT("VB foot_target_l")), RTS_Component);
+	const USkeletalMeshComponent* OwnerComp = GetOwningComponent();
+	FTransform SocketTransformA = BoneCache.GetSocketTransform(OwnerComp, EALSBoneSocket::IK_Foot_L, RTS_Component);
+	FTransform SocketTransformB = BoneCache.GetSocketTransform(OwnerComp, EALSBoneSocket::VB_Foot_Target_L,
+	                                                           RTS_Component);
 	float Distance = (SocketTransformB.GetLocation() - SocketTransformA.GetLocation()).Size();
 	if (Distance > Config.DynamicTransitionThreshold)
 	{
@@ -524,8 +742,8 @@ void UALSCharacterAnimInstance::DynamicTransitionCheck()
 		PlayDynamicTransition(0.1f, Params);
 	}
 
-	SocketTransformA = GetOwningComponent()->GetSocketTransform(FName(TEXT("ik_foot_r")), RTS_Component);
-	SocketTransformB = GetOwningComponent()->GetSocketTransform(FName(TEXT("VB foot_target_r")), RTS_Component);
+	SocketTransformA = BoneCache.GetSocketTransform(OwnerComp, EALSBoneSocket::IK_Foot_R, RTS_Component);
+	SocketTransformB = BoneCache.GetSocketTransform(OwnerComp, EALSBoneSocket::VB_Foot_Target_R, RTS_Component);
 	Distance = (SocketTransformB.GetLocation() - SocketTransformA.GetLocation()).Size();
 	if (Distance > Config.DynamicTransitionThreshold)
 	{
@@ -579,23 +797,16 @@ void UALSCharacterAnimInstance::UpdateRotationValues()
 	// behaves for each movement direction.
 	FRotator Delta = CharacterInformation.Velocity.ToOrientationRotator() - CharacterInformation.AimingRotation;
 	Delta.Normalize();
-	const FVector& FBOffset = YawOffset_FB->GetVectorValue(Delta.Yaw);
+	const FVector& FBOffset = YawOffset_FBTable.GetVectorValue(YawOffset_FB, Delta.Yaw);
 	Grounded.FYaw = FBOffset.X;
 	Grounded.BYaw = FBOffset.Y;
-	const FVector& LROffset = YawOffset_LR->GetVectorValue(Delta.Yaw);
+	const FVector& LROffset = YawOffset_LRTable.GetVectorValue(YawOffset_LR, Delta.Yaw);
 	Grounded.LYaw = LROffset.X;
 	Grounded.RYaw = LROffset.Y;
 }
 
 void UALSCharacterAnimInstance::UpdateInAirValues(float DeltaSeconds)
 {
-	// Update the fall speed. Setting this value only while in the air allows you to use it within the AnimGraph for the landing strength.
-	// If not, the Z velocity would return to 0 on landing.
-	InAir.FallSpeed = CharacterInformation.Velocity.Z;
-
-	// Set the Land Prediction weight.
-	InAir.LandPrediction = CalculateLandPrediction();
-
 	// Interp and set the In Air Lean Amount
 	const FALSLeanAmount& InAirLeanAmount = CalculateAirLeanAmount();
 	LeanAmount.LR = FMath::FInterpTo(LeanAmount.LR, InAirLeanAmount.LR, DeltaSeconds, Config.GroundedLeanInterpSpeed);
@@ -609,28 +820,39 @@ void UALSCharacterAnimInstance::UpdateRagdollValues()
 	FlailRate = FMath::GetMappedRangeValueClamped({0.0f, 1000.0f}, {0.0f, 1.0f}, VelocityLength);
 }
 
-float UALSCharacterAnimInstance::GetAnimCurveClamped(const FName& Name, float Bias, float ClampMin,
+float UALSCharacterAnimInstance::GetAnimCurveClamped(EALSAnimCurve Curve, float Bias, float ClampMin,
                                                      float ClampMax) const
 {
-	return FMath::Clamp(GetCurveValue(Name) + Bias, ClampMin, ClampMax);
+	return FMath::Clamp(CurveValues.Get(Curve) + Bias, ClampMin, ClampMax);
+}
+
+void UALSCharacterAnimInstance::BeginSharedPoseBlendOut(UAnimInstance& LeaderAnimInstance)
+{
+	// The own pose was not evaluated while following, start from the pose that was shown instead
+	LeaderAnimInstance.SnapshotPose(SharedPoseSnapshot);
+	SharedPoseBlendAlpha = SharedPoseSnapshot.bIsValid ? 1.0f : 0.0f;
+}
+
+void UALSCharacterAnimInstance::PlayPooledSlotAnimation(UAnimSequenceBase* Animation, FName SlotName,
+                                                        float BlendInTime, float BlendOutTime, float PlayRate,
+                                                        float StartTime)
+{
+	if (!Animation || !CurrentSkeleton)
+	{
+		return;
+	}
+
+	UAnimMontage* Montage = MontagePool.FindOrCreate(Animation, SlotName, BlendInTime, BlendOutTime);
+	if (Montage)
+	{
+		Montage_Play(Montage, PlayRate, EMontagePlayReturnType::MontageLength, StartTime);
+	}
 }
 
 FALSVelocityBlend UALSCharacterAnimInstance::CalculateVelocityBlend() const
 {
-	// Calculate the Velocity Blend. This value represents the velocity amount of the actor in each direction (normalized so that
-	// diagonals equal .5 for each direction), and is used in a BlendMulti node to produce better
-	// directional blending than a standard blendspace.
-	const FVector LocRelativeVelocityDir =
-		CharacterInformation.CharacterActorRotation.UnrotateVector(CharacterInformation.Velocity.GetSafeNormal(0.1f));
-	const float Sum = FMath::Abs(LocRelativeVelocityDir.X) + FMath::Abs(LocRelativeVelocityDir.Y) +
-		FMath::Abs(LocRelativeVelocityDir.Z);
-	const FVector RelativeDir = LocRelativeVelocityDir / Sum;
-	FALSVelocityBlend Result;
-	Result.F = FMath::Clamp(RelativeDir.X, 0.0f, 1.0f);
-	Result.B = FMath::Abs(FMath::Clamp(RelativeDir.X, -1.0f, 0.0f));
-	Result.L = FMath::Abs(FMath::Clamp(RelativeDir.Y, -1.0f, 0.0f));
-	Result.R = FMath::Clamp(RelativeDir.Y, 0.0f, 1.0f);
-	return Result;
+	return FALSLocomotionCore::CalculateVelocityBlend(CharacterInformation.Velocity,
+	                                                  CharacterInformation.CharacterActorRotation);
 }
 
 FVector UALSCharacterAnimInstance::CalculateRelativeAccelerationAmount() const
@@ -640,15 +862,15 @@ FVector UALSCharacterAnimInstance::CalculateRelativeAccelerationAmount() const
 	// and 1 equals the Max Acceleration of the Character Movement Component.
 	if (FVector::DotProduct(CharacterInformation.Acceleration, CharacterInformation.Velocity) > 0.0f)
 	{
-		const float MaxAcc = Character->GetCharacterMovement()->GetMaxAcceleration();
 		return CharacterInformation.CharacterActorRotation.UnrotateVector(
-			CharacterInformation.Acceleration.GetClampedToMaxSize(MaxAcc) / MaxAcc);
+			CharacterInformation.Acceleration.GetClampedToMaxSize(CharacterInformation.MaxAcceleration) /
+			CharacterInformation.MaxAcceleration);
 	}
 
-	const float MaxBrakingDec = Character->GetCharacterMovement()->GetMaxBrakingDeceleration();
 	return
 		CharacterInformation.CharacterActorRotation.UnrotateVector(
-			CharacterInformation.Acceleration.GetClampedToMaxSize(MaxBrakingDec) / MaxBrakingDec);
+			CharacterInformation.Acceleration.GetClampedToMaxSize(CharacterInformation.MaxBrakingDeceleration) /
+			CharacterInformation.MaxBrakingDeceleration);
 }
 
 float UALSCharacterAnimInstance::CalculateStrideBlend() const
@@ -658,13 +880,13 @@ float UALSCharacterAnimInstance::CalculateStrideBlend() const
 	// It also allows the walk or run gait animations to blend independently while still matching the animation speed to
 	// the movement speed, preventing the character from needing to play a half walk+half run blend.
 	// The curves are used to map the stride amount to the speed for maximum control.
-	const float CurveTime = CharacterInformation.Speed / GetOwningComponent()->GetComponentScale().Z;
-	const float ClampedGait = GetAnimCurveClamped(FName(TEXT("W_Gait")), -1.0, 0.0f, 1.0f);
-	const float LerpedStrideBlend =
-		FMath::Lerp(StrideBlend_N_Walk->GetFloatValue(CurveTime), StrideBlend_N_Run->GetFloatValue(CurveTime),
-		            ClampedGait);
-	return FMath::Lerp(LerpedStrideBlend, StrideBlend_C_Walk->GetFloatValue(CharacterInformation.Speed),
-	                   GetCurveValue(FName(TEXT("BasePose_CLF"))));
+	const float CurveTime = CharacterInformation.Speed / MeshScaleZ;
+	const float ClampedGait = GetAnimCurveClamped(EALSAnimCurve::W_Gait, -1.0, 0.0f, 1.0f);
+	return FALSLocomotionCore::CalculateStrideBlend(
+		StrideBlend_N_WalkTable.GetFloatValue(StrideBlend_N_Walk, CurveTime),
+		StrideBlend_N_RunTable.GetFloatValue(StrideBlend_N_Run, CurveTime),
+		StrideBlend_C_WalkTable.GetFloatValue(StrideBlend_C_Walk, CharacterInformation.Speed),
+		ClampedGait, CurveValues.Get(EALSAnimCurve::BasePose_CLF));
 }
 
 float UALSCharacterAnimInstance::CalculateWalkRunBlend() const
@@ -681,13 +903,12 @@ float UALSCharacterAnimInstance::CalculateStandingPlayRate() const
 	// The value is also divided by the Stride Blend and the mesh scale so that the play rate increases as the stride or scale gets smaller
 	const float LerpedSpeed = FMath::Lerp(CharacterInformation.Speed / Config.AnimatedWalkSpeed,
 	                                      CharacterInformation.Speed / Config.AnimatedRunSpeed,
-	                                      GetAnimCurveClamped(FName(TEXT("W_Gait")), -1.0f, 0.0f, 1.0f));
+	                                      GetAnimCurveClamped(EALSAnimCurve::W_Gait, -1.0f, 0.0f, 1.0f));
 
 	const float SprintAffectedSpeed = FMath::Lerp(LerpedSpeed, CharacterInformation.Speed / Config.AnimatedSprintSpeed,
-	                                              GetAnimCurveClamped(FName(TEXT("W_Gait")), -2.0f, 0.0f, 1.0f));
+	                                              GetAnimCurveClamped(EALSAnimCurve::W_Gait, -2.0f, 0.0f, 1.0f));
 
-	return FMath::Clamp((SprintAffectedSpeed / Grounded.StrideBlend) / GetOwningComponent()->GetComponentScale().Z,
-	                    0.0f, 3.0f);
+	return FMath::Clamp((SprintAffectedSpeed / Grounded.StrideBlend) / MeshScaleZ, 0.0f, 3.0f);
 }
 
 float UALSCharacterAnimInstance::CalculateDiagonalScaleAmount() const
@@ -695,7 +916,8 @@ float UALSCharacterAnimInstance::CalculateDiagonalScaleAmount() const
 	// Calculate the Diagnal Scale Amount. This value is used to scale the Foot IK Root bone to make the Foot IK bones
 	// cover more distance on the diagonal blends. Without scaling, the feet would not move far enough on the diagonal
 	// direction due to the linear translational blending of the IK bones. The curve is used to easily map the value.
-	return DiagonalScaleAmountCurve->GetFloatValue(FMath::Abs(VelocityBlend.F + VelocityBlend.B));
+	return DiagonalScaleAmountTable.GetFloatValue(DiagonalScaleAmountCurve,
+	                                              FMath::Abs(VelocityBlend.F + VelocityBlend.B));
 }
 
 float UALSCharacterAnimInstance::CalculateCrouchingPlayRate() const
@@ -703,51 +925,39 @@ float UALSCharacterAnimInstance::CalculateCrouchingPlayRate() const
 	// Calculate the Crouching Play Rate by dividing the Character's speed by the Animated Speed.
 	// This value needs to be separate from the standing play rate to improve the blend from crocuh to stand while in motion.
 	return FMath::Clamp(
-		CharacterInformation.Speed / Config.AnimatedCrouchSpeed / Grounded.StrideBlend / GetOwningComponent()->
-		GetComponentScale().Z,
-		0.0f, 2.0f);
+		CharacterInformation.Speed / Config.AnimatedCrouchSpeed / Grounded.StrideBlend / MeshScaleZ, 0.0f, 2.0f);
 }
 
 float UALSCharacterAnimInstance::CalculateLandPrediction() const
 {
-	// Calculate the land prediction weight by tracing in the velocity direction to find a walkable surface the character
-	// is falling toward, and getting the 'Time' (range of 0-1, 1 being maximum, 0 being about to land) till impact.
+	ALS_SCOPE_CYCLE_COUNTER(CalculateLandPrediction);
+
+	// Calculate the land prediction weight from the walkable surface the character is predicted to land on,
+	// and getting the 'Time' (range of 0-1, 1 being maximum, 0 being about to land) till impact.
 	// The Land Prediction Curve is used to control how the time affects the final weight for a smooth blend. 
 	if (InAir.FallSpeed >= -200.0f)
 	{
 		return 0.0f;
 	}
 
-	const UCapsuleComponent* CapsuleComp = Character->GetCapsuleComponent();
-	const FVector& CapsuleWorldLoc = CapsuleComp->GetComponentLocation();
-	const float VelocityZ = CharacterInformation.Velocity.Z;
-	FVector VelocityClamped = CharacterInformation.Velocity;
-	VelocityClamped.Z = FMath::Clamp(VelocityZ, -4000.0f, -200.0f);
-	VelocityClamped.Normalize();
-
-	const FVector TraceLength = VelocityClamped * FMath::GetMappedRangeValueClamped(
-		{0.0f, -4000.0f}, {50.0f, 2000.0f}, VelocityZ);
-
-	UWorld* World = GetWorld();
-	check(World);
-
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(Character);
-
-	FHitResult HitResult;
-
-	World->SweepSingleByProfile(HitResult, CapsuleWorldLoc, CapsuleWorldLoc + TraceLength, FQuat::Identity,
-	                            FName(TEXT("ALS_Character")),
-	                            FCollisionShape::MakeCapsule(CapsuleComp->GetUnscaledCapsuleRadius(),
-	                                                         CapsuleComp->GetUnscaledCapsuleHalfHeight()), Params);
+	// The character predicts its landing once per fall, only the distance left to the impact changes
+	if (CharacterInformation.TimeToLand < 0.0f)
+	{
+		return 0.0f;
+	}
 
-	if (Character->GetCharacterMovement()->IsWalkable(HitResult))
+	// Map the distance to the impact over the range of the former velocity sweep
+	const float PredictionDistance = FMath::GetMappedRangeValueClamped({0.0f, -4000.0f}, {50.0f, 2000.0f},
+	                                                                   CharacterInformation.Velocity.Z);
+	const float ImpactDistance = FVector::Dist(CharacterInformation.CapsuleLocation,
+	                                           CharacterInformation.LandImpactLocation);
+	if (ImpactDistance > PredictionDistance)
 	{
-		return FMath::Lerp(LandPredictionCurve->GetFloatValue(HitResult.Time), 0.0f,
-		                   GetCurveValue(FName(TEXT("Mask_LandPrediction"))));
+		return 0.0f;
 	}
 
-	return 0.0f;
+	return FMath::Lerp(LandPredictionTable.GetFloatValue(LandPredictionCurve, ImpactDistance / PredictionDistance),
+	                   0.0f, CurveValues.Get(EALSAnimCurve::Mask_LandPrediction));
 }
 
 FALSLeanAmount UALSCharacterAnimInstance::CalculateAirLeanAmount() const
@@ -759,7 +969,7 @@ FALSLeanAmount UALSCharacterAnimInstance::CalculateAirLeanAmount() const
 	const FVector& UnrotatedVel = CharacterInformation.CharacterActorRotation.UnrotateVector(
 		CharacterInformation.Velocity) / 350.0f;
 	FVector2D InversedVect(UnrotatedVel.Y, UnrotatedVel.X);
-	InversedVect *= LeanInAirCurve->GetFloatValue(InAir.FallSpeed);
+	InversedVect *= LeanInAirTable.GetFloatValue(LeanInAirCurve, InAir.FallSpeed);
 	CalcLeanAmount.LR = InversedVect.X;
 	CalcLeanAmount.FB = InversedVect.Y;
 	return CalcLeanAmount;
@@ -775,9 +985,8 @@ EALSMovementDirection UALSCharacterAnimInstance::CalculateMovementDirection() co
 		return EALSMovementDirection::Forward;
 	}
 
-	FRotator Delta = CharacterInformation.Velocity.ToOrientationRotator() - CharacterInformation.AimingRotation;
-	Delta.Normalize();
-	return UALSMathLibrary::CalculateQuadrant(MovementDirection, 70.0f, -70.0f, 110.0f, -110.0f, 5.0f, Delta.Yaw);
+	// The quadrants of all characters are calculated in one batch by UALSCharacterUpdateSubsystem
+	return CharacterInformation.MovementDirection;
 }
 
 void UALSCharacterAnimInstance::TurnInPlace(FRotator TargetRotation, float PlayRateScale, float StartTime,
@@ -827,8 +1036,8 @@ void UALSCharacterAnimInstance::TurnInPlace(FRotator TargetRotation, float PlayR
 	{
 		return;
 	}
-	PlaySlotAnimationAsDynamicMontage(TargetTurnAsset.Animation, TargetTurnAsset.SlotName, 0.2f, 0.2f,
-	                                  TargetTurnAsset.PlayRate * PlayRateScale, 1, 0.0f, StartTime);
+	PlayPooledSlotAnimation(TargetTurnAsset.Animation, TargetTurnAsset.SlotName, 0.2f, 0.2f,
+	                        TargetTurnAsset.PlayRate * PlayRateScale, StartTime);
 
 	// Step 4: Scale the rotation amount (gets scaled in animgraph) to compensate for turn angle (If Allowed) and play rate.
 	if (TargetTurnAsset.ScaleTurnAngle)
@@ -848,8 +1057,7 @@ void UALSCharacterAnimInstance::OnJumped()
 
 	UWorld* World = GetWorld();
 	check(World);
-	World->GetTimerManager().SetTimer(OnJumpedTimer, this,
-	                                  &UALSCharacterAnimInstance::OnJumpedDelay, 0.1f, false);
+	OnJumpedLatch.Set(World->GetTimeSeconds(), 0.1f);
 }
 
 void UALSCharacterAnimInstance::OnPivot()
@@ -857,6 +1065,5 @@ void UALSCharacterAnimInstance::OnPivot()
 	Grounded.bPivot = CharacterInformation.Speed < Config.TriggerPivotSpeedLimit;
 	UWorld* World = GetWorld();
 	check(World);
-	World->GetTimerManager().SetTimer(OnPivotTimer, this,
-	                                  &UALSCharacterAnimInstance::OnPivotDelay, 0.1f, false);
+	OnPivotLatch.Set(World->GetTimeSeconds(), 0.1f);
 }
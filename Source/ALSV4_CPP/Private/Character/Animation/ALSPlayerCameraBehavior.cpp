@@ -24,3 +24,16 @@ void UALSPlayerCameraBehavior::NativeUpdateAnimation(float DeltaSeconds)
 		bRightShoulder = ControlledPawn->IsRightShoulder();
 	}
 }
+
+void UALSPlayerCameraBehavior::GetCameraBehaviorParams(FALSCameraBehaviorParams& OutParams) const
+{
+	// Params without a curve stay at zero
+	OutParams = FALSCameraBehaviorParams();
+	for (const TPair<FName, float>& Curve : GetAnimationCurveList(EAnimCurveType::AttributeCurve))
+	{
+		if (float* Param = OutParams.FindByCurveName(Curve.Key))
+		{
+			*Param = Curve.Value;
+		}
+	}
+}
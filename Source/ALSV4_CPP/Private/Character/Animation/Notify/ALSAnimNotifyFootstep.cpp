@@ -8,6 +8,7 @@
 
 #include "Character/Animation/Notify/ALSAnimNotifyFootstep.h"
 
+#include "Library/ALSAnimCurveRegistry.h"
 
 #include "Components/AudioComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -19,7 +20,8 @@ void UALSAnimNotifyFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSeque
 		return;
 	}
 
-	const float MaskCurveValue = MeshComp->GetAnimInstance()->GetCurveValue(FName(TEXT("Mask_FootstepSound")));
+	const float MaskCurveValue = MeshComp->GetAnimInstance()->GetCurveValue(
+		FALSAnimCurveRegistry::GetCurveName(EALSAnimCurve::Mask_FootstepSound));
 	const float FinalVolMult = bOverrideMaskCurve ? VolumeMultiplier : VolumeMultiplier * (1.0f - MaskCurveValue);
 
 	if (Sound)
@@ -0,0 +1,99 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSAnimCurveRegistry.h"
+
+#include "Animation/AnimInstance.h"
+#include "Animation/Skeleton.h"
+
+const FName& FALSAnimCurveRegistry::GetCurveName(EALSAnimCurve Curve)
+{
+	static const FName CurveNames[] = {
+		FName(TEXT("Enable_Transition")),
+		FName(TEXT("Mask_AimOffset")),
+		FName(TEXT("BasePose_N")),
+		FName(TEXT("BasePose_CLF")),
+		FName(TEXT("Layering_Spine_Add")),
+		FName(TEXT("Layering_Head_Add")),
+		FName(TEXT("Layering_Arm_L_Add")),
+		FName(TEXT("Layering_Arm_R_Add")),
+		FName(TEXT("Layering_Hand_R")),
+		FName(TEXT("Layering_Hand_L")),
+		FName(TEXT("Layering_Arm_L")),
+		FName(TEXT("Layering_Arm_R")),
+		FName(TEXT("Layering_Arm_L_LS")),
+		FName(TEXT("Layering_Arm_R_LS")),
+		FName(TEXT("Enable_HandIK_L")),
+		FName(TEXT("Enable_HandIK_R")),
+		FName(TEXT("Enable_FootIK_L")),
+		FName(TEXT("Enable_FootIK_R")),
+		FName(TEXT("FootLock_L")),
+		FName(TEXT("FootLock_R")),
+		FName(TEXT("RotationAmount")),
+		FName(TEXT("YawOffset")),
+		FName(TEXT("W_Gait")),
+		FName(TEXT("Mask_LandPrediction")),
+		FName(TEXT("Mask_FootstepSound")),
+	};
+	static_assert(UE_ARRAY_COUNT(CurveNames) == static_cast<uint8>(EALSAnimCurve::MAX),
+	              "Every ALS curve needs a name");
+
+	return CurveNames[static_cast<uint8>(Curve)];
+}
+
+void FALSAnimCurveRegistry::Initialize(const USkeleton* NewSkeleton)
+{
+	Skeleton = NewSkeleton;
+	bInitialized = true;
+
+	SkeletonCurves.Reset();
+	if (!NewSkeleton)
+	{
+		return;
+	}
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EALSAnimCurve::MAX); ++Index)
+	{
+		const EALSAnimCurve Curve = static_cast<EALSAnimCurve>(Index);
+		if (NewSkeleton->GetUIDByName(USkeleton::AnimCurveMappingName, GetCurveName(Curve)) != SmartName::MaxUID)
+		{
+			SkeletonCurves.Emplace(GetCurveName(Curve), Curve);
+		}
+	}
+}
+
+void FALSAnimCurveRegistry::ReadCurveValues(const UAnimInstance& AnimInstance, FALSAnimCurveValues& OutValues) const
+{
+	// Curves which are not evaluated stay at zero
+	OutValues = FALSAnimCurveValues();
+	if (SkeletonCurves.Num() == 0)
+	{
+		return;
+	}
+
+	// Walk the evaluated curves once and match them against the few ALS curves of the skeleton, comparing names
+	// instead of hashing them, and stop as soon as every ALS curve was found
+	int32 NumFound = 0;
+	for (const TPair<FName, float>& Curve : AnimInstance.GetAnimationCurveList(EAnimCurveType::AttributeCurve))
+	{
+		for (const TPair<FName, EALSAnimCurve>& SkeletonCurve : SkeletonCurves)
+		{
+			if (SkeletonCurve.Key == Curve.Key)
+			{
+				OutValues.Values[static_cast<uint8>(SkeletonCurve.Value)] = Curve.Value;
+				++NumFound;
+				break;
+			}
+		}
+
+		if (NumFound == SkeletonCurves.Num())
+		{
+			break;
+		}
+	}
+}
@@ -0,0 +1,93 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSBoneCache.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/SkeletalMeshSocket.h"
+
+FALSBoneCache::FALSBoneCache()
+{
+	for (int32& BoneIndex : BoneIndices)
+	{
+		BoneIndex = INDEX_NONE;
+	}
+}
+
+const FName& FALSBoneCache::GetSocketName(EALSBoneSocket Socket)
+{
+	static const FName SocketNames[] = {
+		FName(TEXT("root")),
+		FName(TEXT("Pelvis")),
+		FName(TEXT("Head")),
+		FName(TEXT("FP_Camera")),
+		FName(TEXT("TP_CameraTrace_L")),
+		FName(TEXT("TP_CameraTrace_R")),
+		FName(TEXT("ik_foot_l")),
+		FName(TEXT("ik_foot_r")),
+		FName(TEXT("VB foot_target_l")),
+		FName(TEXT("VB foot_target_r")),
+	};
+	static_assert(UE_ARRAY_COUNT(SocketNames) == static_cast<uint8>(EALSBoneSocket::MAX),
+	              "Every ALS bone or socket needs a name");
+
+	return SocketNames[static_cast<uint8>(Socket)];
+}
+
+FTransform FALSBoneCache::GetSocketTransform(const USkeletalMeshComponent* Mesh, EALSBoneSocket Socket,
+                                             ERelativeTransformSpace TransformSpace) const
+{
+	check(Mesh);
+
+	if (!bBuilt || CachedSkeletalMesh.Get() != Mesh->SkeletalMesh)
+	{
+		Rebuild(Mesh);
+	}
+
+	const uint8 Index = static_cast<uint8>(Socket);
+	const int32 BoneIndex = BoneIndices[Index];
+	const TArray<FTransform>& ComponentSpaceTransforms = Mesh->GetComponentSpaceTransforms();
+
+	// Slaves of a master pose component read their bones through the master, leave those to the engine.
+	// Same for bones that are missing, or a pose that is not evaluated yet.
+	const bool bCanUseCache = !Mesh->MasterPoseComponent.IsValid()
+		&& ComponentSpaceTransforms.IsValidIndex(BoneIndex)
+		&& (TransformSpace == RTS_World || TransformSpace == RTS_Component);
+	if (!bCanUseCache)
+	{
+		return Mesh->GetSocketTransform(GetSocketName(Socket), TransformSpace);
+	}
+
+	const FTransform ComponentSpaceTransform = SocketLocalTransforms[Index] * ComponentSpaceTransforms[BoneIndex];
+	return TransformSpace == RTS_World
+		       ? ComponentSpaceTransform * Mesh->GetComponentTransform()
+		       : ComponentSpaceTransform;
+}
+
+void FALSBoneCache::Rebuild(const USkeletalMeshComponent* Mesh) const
+{
+	CachedSkeletalMesh = Mesh->SkeletalMesh;
+	bBuilt = true;
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EALSBoneSocket::MAX); ++Index)
+	{
+		const FName& Name = GetSocketName(static_cast<EALSBoneSocket>(Index));
+		const USkeletalMeshSocket* MeshSocket = Mesh->SkeletalMesh ? Mesh->SkeletalMesh->FindSocket(Name) : nullptr;
+		if (MeshSocket)
+		{
+			BoneIndices[Index] = Mesh->GetBoneIndex(MeshSocket->BoneName);
+			SocketLocalTransforms[Index] = MeshSocket->GetSocketLocalTransform();
+		}
+		else
+		{
+			BoneIndices[Index] = Mesh->GetBoneIndex(Name);
+			SocketLocalTransforms[Index] = FTransform::Identity;
+		}
+	}
+}
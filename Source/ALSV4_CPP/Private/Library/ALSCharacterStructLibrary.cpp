@@ -0,0 +1,48 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSCharacterStructLibrary.h"
+
+float* FALSCameraBehaviorParams::FindByCurveName(FName CurveName)
+{
+	static const FName NAME_RotationLagSpeed(TEXT("RotationLagSpeed"));
+	static const FName NAME_PivotLagSpeed_X(TEXT("PivotLagSpeed_X"));
+	static const FName NAME_PivotLagSpeed_Y(TEXT("PivotLagSpeed_Y"));
+	static const FName NAME_PivotLagSpeed_Z(TEXT("PivotLagSpeed_Z"));
+	static const FName NAME_PivotOffset_X(TEXT("PivotOffset_X"));
+	static const FName NAME_PivotOffset_Y(TEXT("PivotOffset_Y"));
+	static const FName NAME_PivotOffset_Z(TEXT("PivotOffset_Z"));
+	static const FName NAME_CameraOffset_X(TEXT("CameraOffset_X"));
+	static const FName NAME_CameraOffset_Y(TEXT("CameraOffset_Y"));
+	static const FName NAME_CameraOffset_Z(TEXT("CameraOffset_Z"));
+	static const FName NAME_Override_Debug(TEXT("Override_Debug"));
+	static const FName NAME_Weight_FirstPerson(TEXT("Weight_FirstPerson"));
+
+	const TPair<FName, float*> Params[] = {
+		{NAME_RotationLagSpeed, &RotationLagSpeed},
+		{NAME_PivotLagSpeed_X, &PivotLagSpeed.X},
+		{NAME_PivotLagSpeed_Y, &PivotLagSpeed.Y},
+		{NAME_PivotLagSpeed_Z, &PivotLagSpeed.Z},
+		{NAME_PivotOffset_X, &PivotOffset.X},
+		{NAME_PivotOffset_Y, &PivotOffset.Y},
+		{NAME_PivotOffset_Z, &PivotOffset.Z},
+		{NAME_CameraOffset_X, &CameraOffset.X},
+		{NAME_CameraOffset_Y, &CameraOffset.Y},
+		{NAME_CameraOffset_Z, &CameraOffset.Z},
+		{NAME_Override_Debug, &OverrideDebug},
+		{NAME_Weight_FirstPerson, &WeightFirstPerson},
+	};
+	for (const TPair<FName, float*>& Param : Params)
+	{
+		if (Param.Key == CurveName)
+		{
+			return Param.Value;
+		}
+	}
+	return nullptr;
+}
@@ -0,0 +1,303 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSCurveTable.h"
+
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveVector.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Library/ALSLog.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+static bool GALSCurveTablesEnabled = true;
+static float GALSCurveTableMaxError = 0.001f;
+static int32 GALSCurveTableMinSamples = 16;
+static int32 GALSCurveTableMaxSamples = 1024;
+static bool GALSCurveTablesValidate = false;
+
+static void OnCurveTableSettingsChanged(IConsoleVariable* Variable)
+{
+	FALSCurveTableCache::Flush();
+}
+
+static FAutoConsoleVariableRef CVarALSCurveTables(
+	TEXT("ALS.CurveTables"),
+	GALSCurveTablesEnabled,
+	TEXT("Evaluate locomotion curves through baked lookup tables."),
+	FConsoleVariableDelegate::CreateStatic(&OnCurveTableSettingsChanged));
+
+static FAutoConsoleVariableRef CVarALSCurveTableMaxError(
+	TEXT("ALS.CurveTables.MaxError"),
+	GALSCurveTableMaxError,
+	TEXT("Largest allowed difference between a table and its curve, relative to the largest absolute curve value."),
+	FConsoleVariableDelegate::CreateStatic(&OnCurveTableSettingsChanged));
+
+static FAutoConsoleVariableRef CVarALSCurveTableMinSamples(
+	TEXT("ALS.CurveTables.MinSamples"),
+	GALSCurveTableMinSamples,
+	TEXT("Number of samples baking starts with, doubled until the table is within the error bound."),
+	FConsoleVariableDelegate::CreateStatic(&OnCurveTableSettingsChanged));
+
+static FAutoConsoleVariableRef CVarALSCurveTableMaxSamples(
+	TEXT("ALS.CurveTables.MaxSamples"),
+	GALSCurveTableMaxSamples,
+	TEXT("Largest number of samples per channel. Curves that need more are evaluated directly."),
+	FConsoleVariableDelegate::CreateStatic(&OnCurveTableSettingsChanged));
+
+static FAutoConsoleVariableRef CVarALSCurveTablesValidate(
+	TEXT("ALS.CurveTables.Validate"),
+	GALSCurveTablesValidate,
+	TEXT("Compare every table read against its curve and log reads outside the error bound."));
+
+namespace
+{
+	/** Points checked between two samples while baking */
+	constexpr int32 ValidationStepsPerSample = 16;
+
+	FRWLock GCurveTablesLock;
+	TMap<FObjectKey, FALSCurveTablePtr> GCurveTables;
+	FThreadSafeCounter GCurveTablesGeneration;
+
+	int32 GetCurveChannels(const UCurveBase* Curve, const FRichCurve* OutChannels[3])
+	{
+		if (const UCurveFloat* FloatCurve = Cast<UCurveFloat>(Curve))
+		{
+			OutChannels[0] = &FloatCurve->FloatCurve;
+			return 1;
+		}
+		if (const UCurveVector* VectorCurve = Cast<UCurveVector>(Curve))
+		{
+			for (int32 Channel = 0; Channel < 3; ++Channel)
+			{
+				OutChannels[Channel] = &VectorCurve->FloatCurves[Channel];
+			}
+			return 3;
+		}
+		return 0;
+	}
+
+	FALSCurveTablePtr BakeCurve(const UCurveBase* Curve)
+	{
+		const FRichCurve* Channels[3];
+		const int32 NumChannels = GetCurveChannels(Curve, Channels);
+		if (NumChannels == 0)
+		{
+			return nullptr;
+		}
+
+		// Step 1: Find the time and value range of all channels. Outside of the time range the table repeats
+		// its first and last samples, which only matches the curve with constant extrapolation.
+		float MinTime = MAX_flt;
+		float MaxTime = -MAX_flt;
+		float MinValue = MAX_flt;
+		float MaxValue = -MAX_flt;
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			const FRichCurve& RichCurve = *Channels[Channel];
+			if (RichCurve.PreInfinityExtrap != RCCE_Constant || RichCurve.PostInfinityExtrap != RCCE_Constant)
+			{
+				return nullptr;
+			}
+			if (RichCurve.GetNumKeys() > 0)
+			{
+				float ChannelMinTime, ChannelMaxTime, ChannelMinValue, ChannelMaxValue;
+				RichCurve.GetTimeRange(ChannelMinTime, ChannelMaxTime);
+				RichCurve.GetValueRange(ChannelMinValue, ChannelMaxValue);
+				MinTime = FMath::Min(MinTime, ChannelMinTime);
+				MaxTime = FMath::Max(MaxTime, ChannelMaxTime);
+				MinValue = FMath::Min(MinValue, ChannelMinValue);
+				MaxValue = FMath::Max(MaxValue, ChannelMaxValue);
+			}
+		}
+
+		const bool bConstant = MinTime >= MaxTime;
+		if (MinTime > MaxTime)
+		{
+			// No keys at all, every channel evaluates to its default value
+			MinTime = MaxTime = 0.0f;
+			MinValue = MaxValue = 0.0f;
+		}
+
+		// The bound scales with the magnitude of the curve, so curves with small values get an equally tight bound
+		const float Magnitude = FMath::Max(FMath::Abs(MinValue), FMath::Abs(MaxValue));
+		const float MaxError = GALSCurveTableMaxError * FMath::Max(Magnitude, SMALL_NUMBER);
+		const int32 MaxSamples = FMath::Max(2, GALSCurveTableMaxSamples);
+
+		// Step 2: Sample the curve, doubling the resolution until the largest difference between samples
+		// stays within the error bound.
+		for (int32 NumSamples = bConstant ? 2 : FMath::Clamp(GALSCurveTableMinSamples, 2, MaxSamples);;
+		     NumSamples = FMath::Min(NumSamples * 2, MaxSamples))
+		{
+			const float SampleInterval = bConstant ? 0.0f : (MaxTime - MinTime) / (NumSamples - 1);
+
+			TSharedRef<FALSCurveTable, ESPMode::ThreadSafe> Table = MakeShared<FALSCurveTable, ESPMode::ThreadSafe>();
+			Table->MinTime = MinTime;
+			Table->InvSampleInterval = bConstant ? 0.0f : 1.0f / SampleInterval;
+			Table->NumSamples = NumSamples;
+			Table->NumChannels = NumChannels;
+			Table->MaxError = MaxError;
+			Table->Samples.SetNumUninitialized(NumSamples * NumChannels);
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				for (int32 Index = 0; Index < NumSamples; ++Index)
+				{
+					Table->Samples[Channel * NumSamples + Index] = Channels[Channel]->Eval(
+						MinTime + Index * SampleInterval);
+				}
+			}
+
+			// Compare against the curve across the whole of each interval, so narrow bumps between samples are found
+			float Error = 0.0f;
+			for (int32 Index = 0; !bConstant && Index < NumSamples - 1; ++Index)
+			{
+				for (int32 Step = 0; Step <= ValidationStepsPerSample; ++Step)
+				{
+					const float Fraction = static_cast<float>(Step) / ValidationStepsPerSample;
+					const float Time = MinTime + (Index + Fraction) * SampleInterval;
+					for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+					{
+						const float TableValue = FMath::Lerp(Table->Samples[Channel * NumSamples + Index],
+						                                     Table->Samples[Channel * NumSamples + Index + 1],
+						                                     Fraction);
+						Error = FMath::Max(Error, FMath::Abs(TableValue - Channels[Channel]->Eval(Time)));
+					}
+				}
+			}
+
+			if (Error <= MaxError)
+			{
+				return Table;
+			}
+
+			if (NumSamples >= MaxSamples)
+			{
+				UE_LOG(LogALS, Verbose, TEXT("Curve %s is evaluated directly, error of %f with %d samples exceeds %f"),
+				       *Curve->GetPathName(), Error, NumSamples, MaxError);
+				return nullptr;
+			}
+		}
+	}
+
+#if WITH_EDITOR
+	void OnObjectModified(UObject* Object)
+	{
+		if (Object && Object->IsA<UCurveBase>())
+		{
+			FRWScopeLock Lock(GCurveTablesLock, SLT_Write);
+			if (GCurveTables.Remove(FObjectKey(Object)) > 0)
+			{
+				GCurveTablesGeneration.Increment();
+			}
+		}
+	}
+#endif
+}
+
+FALSCurveTablePtr FALSCurveTableCache::FindOrBake(const UCurveBase* Curve)
+{
+	if (!Curve || !GALSCurveTablesEnabled)
+	{
+		return nullptr;
+	}
+
+	const FObjectKey Key(Curve);
+	{
+		FRWScopeLock Lock(GCurveTablesLock, SLT_ReadOnly);
+		if (const FALSCurveTablePtr* Table = GCurveTables.Find(Key))
+		{
+			return *Table;
+		}
+	}
+
+	FALSCurveTablePtr Table = BakeCurve(Curve);
+
+	FRWScopeLock Lock(GCurveTablesLock, SLT_Write);
+
+#if WITH_EDITOR
+	static bool bRegisteredEditorCallbacks = false;
+	if (!bRegisteredEditorCallbacks)
+	{
+		// Tables of curves edited while playing are baked again
+		bRegisteredEditorCallbacks = true;
+		FCoreUObjectDelegates::OnObjectModified.AddStatic(&OnObjectModified);
+	}
+#endif
+
+	// Another thread may have baked the same curve in the meantime
+	if (const FALSCurveTablePtr* ExistingTable = GCurveTables.Find(Key))
+	{
+		return *ExistingTable;
+	}
+	return GCurveTables.Add(Key, Table);
+}
+
+void FALSCurveTableCache::Flush()
+{
+	FRWScopeLock Lock(GCurveTablesLock, SLT_Write);
+	GCurveTables.Reset();
+	GCurveTablesGeneration.Increment();
+}
+
+uint32 FALSCurveTableCache::GetGeneration()
+{
+	return static_cast<uint32>(GCurveTablesGeneration.GetValue());
+}
+
+float FALSCurveTableHandle::GetFloatValue(const UCurveFloat* Curve, float Time) const
+{
+	Bind(Curve);
+	if (!Table.IsValid())
+	{
+		return Curve->GetFloatValue(Time);
+	}
+
+	const float Value = Table->GetFloatValue(Time);
+	if (GALSCurveTablesValidate)
+	{
+		const float CurveValue = Curve->GetFloatValue(Time);
+		UE_CLOG(FMath::Abs(Value - CurveValue) > Table->MaxError, LogALS, Warning,
+		        TEXT("Table of curve %s returned %f at time %f, curve value is %f"),
+		        *Curve->GetPathName(), Value, Time, CurveValue);
+	}
+	return Value;
+}
+
+FVector FALSCurveTableHandle::GetVectorValue(const UCurveVector* Curve, float Time) const
+{
+	Bind(Curve);
+	if (!Table.IsValid())
+	{
+		return Curve->GetVectorValue(Time);
+	}
+
+	const FVector Value = Table->GetVectorValue(Time);
+	if (GALSCurveTablesValidate)
+	{
+		const FVector CurveValue = Curve->GetVectorValue(Time);
+		UE_CLOG(!Value.Equals(CurveValue, Table->MaxError), LogALS, Warning,
+		        TEXT("Table of curve %s returned %s at time %f, curve value is %s"),
+		        *Curve->GetPathName(), *Value.ToString(), Time, *CurveValue.ToString());
+	}
+	return Value;
+}
+
+void FALSCurveTableHandle::Bind(const UCurveBase* Curve) const
+{
+	check(Curve);
+
+	const uint32 Generation = FALSCurveTableCache::GetGeneration();
+	if (BoundCurve.Get() != Curve || BoundGeneration != Generation)
+	{
+		BoundCurve = Curve;
+		BoundGeneration = Generation;
+		Table = FALSCurveTableCache::FindOrBake(Curve);
+	}
+}
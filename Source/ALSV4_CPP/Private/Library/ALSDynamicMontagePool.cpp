@@ -0,0 +1,39 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSDynamicMontagePool.h"
+
+#include "Animation/AnimMontage.h"
+#include "Library/ALSStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dynamic Montages Built"), STAT_ALS_DynamicMontagesBuilt, STATGROUP_ALS);
+
+UAnimMontage* FALSDynamicMontagePool::FindOrCreate(UAnimSequenceBase* Animation, FName SlotName, float BlendInTime,
+                                                   float BlendOutTime)
+{
+	// Only a few animations are played per instance, a linear search is enough
+	for (UAnimMontage* Montage : Montages)
+	{
+		const FSlotAnimationTrack& Track = Montage->SlotAnimTracks[0];
+		if (Track.AnimTrack.AnimSegments[0].AnimReference == Animation && Track.SlotName == SlotName &&
+			Montage->BlendIn.GetBlendTime() == BlendInTime && Montage->BlendOut.GetBlendTime() == BlendOutTime)
+		{
+			return Montage;
+		}
+	}
+
+	// Play rate and start time are passed when the montage is played, they don't need a montage of their own
+	UAnimMontage* Montage = UAnimMontage::CreateSlotAnimationAsDynamicMontage(
+		Animation, SlotName, BlendInTime, BlendOutTime, 1.0f, 1, 0.0f, 0.0f);
+	if (Montage)
+	{
+		INC_DWORD_STAT(STAT_ALS_DynamicMontagesBuilt);
+		Montages.Add(Montage);
+	}
+	return Montage;
+}
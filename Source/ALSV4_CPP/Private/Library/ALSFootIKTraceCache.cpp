@@ -0,0 +1,64 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSFootIKTraceCache.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarFootIKTraceCache(
+	TEXT("ALS.FootIK.TraceCache"),
+	1,
+	TEXT("If non zero, foot IK trace results are reused while the feet and the surface below them do not move."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarFootIKTraceCacheThreshold(
+	TEXT("ALS.FootIK.TraceCache.Threshold"),
+	2.0f,
+	TEXT("Distance a foot can move from the location it was traced from before it is traced again."),
+	ECVF_Default);
+
+bool FALSFootIKTraceCache::CanReuse(const FVector& NewFloorLocation) const
+{
+	if (!bValid || CVarFootIKTraceCache.GetValueOnAnyThread() == 0)
+	{
+		return false;
+	}
+
+	const float Threshold = CVarFootIKTraceCacheThreshold.GetValueOnAnyThread();
+	if (FVector::DistSquared(NewFloorLocation, FloorLocation) > FMath::Square(Threshold))
+	{
+		return false;
+	}
+
+	const UPrimitiveComponent* HitComponent = Component.Get();
+	if (!HitComponent)
+	{
+		return false;
+	}
+
+	// Static components can't move, skip comparing their transform
+	return HitComponent->Mobility == EComponentMobility::Static ||
+		HitComponent->GetComponentTransform().Equals(ComponentTransform);
+}
+
+void FALSFootIKTraceCache::Store(const FHitResult& HitResult, bool bWalkable, const FVector& TracedFloorLocation)
+{
+	const UPrimitiveComponent* HitComponent = HitResult.GetComponent();
+	bValid = bWalkable && HitComponent != nullptr;
+	if (!bValid)
+	{
+		return;
+	}
+
+	FloorLocation = TracedFloorLocation;
+	ImpactPoint = HitResult.ImpactPoint;
+	ImpactNormal = HitResult.ImpactNormal;
+	Component = HitComponent;
+	ComponentTransform = HitComponent->GetComponentTransform();
+}
@@ -0,0 +1,153 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSLandPrediction.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Library/ALSStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Predict Land"), STAT_ALS_PredictLand, STATGROUP_ALS);
+
+static TAutoConsoleVariable<float> CVarLandPredictionMaxTime(
+	TEXT("ALS.LandPrediction.MaxTime"),
+	2.0f,
+	TEXT("Seconds of the ballistic arc swept to predict the landing of a falling character."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLandPredictionSegments(
+	TEXT("ALS.LandPrediction.Segments"),
+	8,
+	TEXT("Number of sweeps the predicted arc is split into."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarLandPredictionTolerance(
+	TEXT("ALS.LandPrediction.Tolerance"),
+	20.0f,
+	TEXT("Distance a falling character can drift from the predicted arc before the arc is swept again."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarLandPredictionVelocityTolerance(
+	TEXT("ALS.LandPrediction.VelocityTolerance"),
+	50.0f,
+	TEXT("Velocity difference to the predicted arc a falling character can have before the arc is swept again."),
+	ECVF_Default);
+
+void FALSLandPrediction::Predict(const ACharacter& Character, const FCollisionQueryParams& QueryParams, float Time)
+{
+	ALS_SCOPE_CYCLE_COUNTER(PredictLand);
+
+	const UCharacterMovementComponent* CharacterMovement = Character.GetCharacterMovement();
+	const UCapsuleComponent* CapsuleComp = Character.GetCapsuleComponent();
+	const UWorld* World = Character.GetWorld();
+	check(World);
+
+	StartTime = Time;
+	StartLocation = CapsuleComp->GetComponentLocation();
+	StartVelocity = CharacterMovement->Velocity;
+	GravityZ = CharacterMovement->GetGravityZ();
+	bHit = false;
+	bWalkable = false;
+	bValid = true;
+
+	const float MaxTime = FMath::Max(CVarLandPredictionMaxTime.GetValueOnGameThread(), KINDA_SMALL_NUMBER);
+	const int32 NumSegments = FMath::Max(CVarLandPredictionSegments.GetValueOnGameThread(), 1);
+	const float SegmentTime = MaxTime / NumSegments;
+	Duration = MaxTime;
+
+	const FCollisionShape CapsuleShape = FCollisionShape::MakeCapsule(CapsuleComp->GetUnscaledCapsuleRadius(),
+	                                                                  CapsuleComp->GetUnscaledCapsuleHalfHeight());
+
+	// Sweep the arc segment by segment and stop at the first surface
+	FVector SegmentStart = StartLocation;
+	for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+	{
+		const FVector SegmentEnd = GetLocationAt(StartTime + (Segment + 1) * SegmentTime);
+
+		FHitResult HitResult;
+		{
+			ALS_SCOPE_TRACE();
+			World->SweepSingleByProfile(HitResult, SegmentStart, SegmentEnd, FQuat::Identity,
+			                            FName(TEXT("ALS_Character")), CapsuleShape, QueryParams);
+		}
+
+		if (HitResult.bBlockingHit)
+		{
+			const UPrimitiveComponent* HitComponent = HitResult.GetComponent();
+			Duration = (Segment + HitResult.Time) * SegmentTime;
+			ImpactLocation = HitResult.Location;
+			ImpactNormal = HitResult.ImpactNormal;
+			Component = HitComponent;
+			ComponentTransform = HitComponent ? HitComponent->GetComponentTransform() : FTransform::Identity;
+			bHit = true;
+			bWalkable = CharacterMovement->IsWalkable(HitResult);
+			return;
+		}
+
+		SegmentStart = SegmentEnd;
+	}
+}
+
+bool FALSLandPrediction::IsInvalidated(const ACharacter& Character, float Time) const
+{
+	if (!bValid || Time - StartTime >= Duration)
+	{
+		return true;
+	}
+
+	// Air control, launches and collisions move the character off the arc
+	const UCharacterMovementComponent* CharacterMovement = Character.GetCharacterMovement();
+	if (CharacterMovement->GetGravityZ() != GravityZ ||
+		!CharacterMovement->Velocity.Equals(GetVelocityAt(Time),
+		                                    CVarLandPredictionVelocityTolerance.GetValueOnGameThread()) ||
+		!Character.GetCapsuleComponent()->GetComponentLocation().Equals(
+			GetLocationAt(Time), CVarLandPredictionTolerance.GetValueOnGameThread()))
+	{
+		return true;
+	}
+
+	if (!bHit)
+	{
+		return false;
+	}
+
+	const UPrimitiveComponent* HitComponent = Component.Get();
+	if (!HitComponent)
+	{
+		return true;
+	}
+
+	// Static components can't move, skip comparing their transform
+	return HitComponent->Mobility != EComponentMobility::Static &&
+		!HitComponent->GetComponentTransform().Equals(ComponentTransform);
+}
+
+float FALSLandPrediction::GetTimeToLand(float Time) const
+{
+	if (!bValid || !bHit || !bWalkable)
+	{
+		return -1.0f;
+	}
+
+	return FMath::Max(StartTime + Duration - Time, 0.0f);
+}
+
+FVector FALSLandPrediction::GetLocationAt(float Time) const
+{
+	const float ElapsedTime = Time - StartTime;
+	return StartLocation + StartVelocity * ElapsedTime +
+		FVector(0.0f, 0.0f, 0.5f * GravityZ * FMath::Square(ElapsedTime));
+}
+
+FVector FALSLandPrediction::GetVelocityAt(float Time) const
+{
+	return StartVelocity + FVector(0.0f, 0.0f, GravityZ * (Time - StartTime));
+}
@@ -0,0 +1,184 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSLocomotionCore.h"
+
+bool FALSLocomotionCore::CanSprint(const FALSGaitState& State)
+{
+	// Determine if the character is currently able to sprint based on the Rotation mode and current acceleration
+	// (input) rotation. If the character is in the Looking Rotation mode, only allow sprinting if there is full
+	// movement input and it is faced forward relative to the camera + or - 50 degrees.
+
+	if (!State.bHasMovementInput || State.RotationMode == EALSRotationMode::Aiming)
+	{
+		return false;
+	}
+
+	const bool bValidInputAmount = State.MovementInputAmount > 0.9f;
+
+	if (State.RotationMode == EALSRotationMode::VelocityDirection)
+	{
+		return bValidInputAmount;
+	}
+
+	if (State.RotationMode == EALSRotationMode::LookingDirection)
+	{
+		const FRotator AccRot = State.MovementInput.ToOrientationRotator();
+		FRotator Delta = AccRot - State.AimingRotation;
+		Delta.Normalize();
+
+		return bValidInputAmount && FMath::Abs(Delta.Yaw) < 50.0f;
+	}
+
+	return false;
+}
+
+EALSGait FALSLocomotionCore::GetAllowedGait(const FALSGaitState& State)
+{
+	// Calculate the Allowed Gait. This represents the maximum Gait the character is currently allowed to be in,
+	// and can be determined by the desired gait, the rotation mode, the stance, etc. For example,
+	// if you wanted to force the character into a walking state while indoors, this could be done here.
+
+	if (State.Stance == EALSStance::Standing)
+	{
+		if (State.RotationMode != EALSRotationMode::Aiming)
+		{
+			if (State.DesiredGait == EALSGait::Sprinting)
+			{
+				return CanSprint(State) ? EALSGait::Sprinting : EALSGait::Running;
+			}
+			return State.DesiredGait;
+		}
+	}
+
+	// Crouching stance & Aiming rot mode has same behaviour
+
+	if (State.DesiredGait == EALSGait::Sprinting)
+	{
+		return EALSGait::Running;
+	}
+
+	return State.DesiredGait;
+}
+
+EALSGait FALSLocomotionCore::GetActualGait(const FALSGaitState& State, const FALSMovementSettings& Settings,
+                                           EALSGait AllowedGait)
+{
+	// Get the Actual Gait. This is calculated by the actual movement of the character,  and so it can be different
+	// from the desired gait or allowed gait. For instance, if the Allowed Gait becomes walking,
+	// the Actual gait will still be running untill the character decelerates to the walking speed.
+
+	if (State.Speed > Settings.RunSpeed + 10.0f)
+	{
+		if (AllowedGait == EALSGait::Sprinting)
+		{
+			return EALSGait::Sprinting;
+		}
+		return EALSGait::Running;
+	}
+
+	if (State.Speed >= Settings.WalkSpeed + 10.0f)
+	{
+		return EALSGait::Running;
+	}
+
+	return EALSGait::Walking;
+}
+
+float FALSLocomotionCore::GetMappedSpeed(float Speed, const FALSMovementSettings& Settings)
+{
+	// Map the character's current speed to the configured movement speeds with a range of 0-3,
+	// with 0 = stopped, 1 = the Walk Speed, 2 = the Run Speed, and 3 = the Sprint Speed.
+	// This allows us to vary the movement speeds but still use the mapped range in calculations for consistent results
+
+	if (Speed > Settings.RunSpeed)
+	{
+		return FMath::GetMappedRangeValueClamped({Settings.RunSpeed, Settings.SprintSpeed}, {2.0f, 3.0f}, Speed);
+	}
+
+	if (Speed > Settings.WalkSpeed)
+	{
+		return FMath::GetMappedRangeValueClamped({Settings.WalkSpeed, Settings.RunSpeed}, {1.0f, 2.0f}, Speed);
+	}
+
+	return FMath::GetMappedRangeValueClamped({0.0f, Settings.WalkSpeed}, {0.0f, 1.0f}, Speed);
+}
+
+FRotator FALSLocomotionCore::SmoothRotation(const FRotator& ActorRotation, FRotator& InOutTargetRotation,
+                                            const FRotator& Target, float TargetInterpSpeed, float ActorInterpSpeed,
+                                            float DeltaTime)
+{
+	// Interpolate the Target Rotation for extra smooth rotation behavior
+	InOutTargetRotation = FMath::RInterpConstantTo(InOutTargetRotation, Target, DeltaTime, TargetInterpSpeed);
+	return FMath::RInterpTo(ActorRotation, InOutTargetRotation, DeltaTime, ActorInterpSpeed);
+}
+
+FALSVelocityBlend FALSLocomotionCore::CalculateVelocityBlend(const FVector& Velocity, const FRotator& ActorRotation)
+{
+	// Calculate the Velocity Blend. This value represents the velocity amount of the actor in each direction (normalized so that
+	// diagonals equal .5 for each direction), and is used in a BlendMulti node to produce better
+	// directional blending than a standard blendspace.
+	const FVector LocRelativeVelocityDir = ActorRotation.UnrotateVector(Velocity.GetSafeNormal(0.1f));
+	const float Sum = FMath::Abs(LocRelativeVelocityDir.X) + FMath::Abs(LocRelativeVelocityDir.Y) +
+		FMath::Abs(LocRelativeVelocityDir.Z);
+	const FVector RelativeDir = LocRelativeVelocityDir / Sum;
+	FALSVelocityBlend Result;
+	Result.F = FMath::Clamp(RelativeDir.X, 0.0f, 1.0f);
+	Result.B = FMath::Abs(FMath::Clamp(RelativeDir.X, -1.0f, 0.0f));
+	Result.L = FMath::Abs(FMath::Clamp(RelativeDir.Y, -1.0f, 0.0f));
+	Result.R = FMath::Clamp(RelativeDir.Y, 0.0f, 1.0f);
+	return Result;
+}
+
+float FALSLocomotionCore::CalculateStrideBlend(float WalkStride, float RunStride, float CrouchStride,
+                                               float GaitWeight, float CrouchWeight)
+{
+	const float LerpedStrideBlend = FMath::Lerp(WalkStride, RunStride, GaitWeight);
+	return FMath::Lerp(LerpedStrideBlend, CrouchStride, CrouchWeight);
+}
+
+void FALSLocomotionCore::RotateInPlaceCheck(float AimingAngle, float AimYawRate, const FALSAnimRotateInPlace& Settings,
+                                            FALSAnimGraphGrounded& Grounded)
+{
+	// Step 1: Check if the character should rotate left or right by checking if the Aiming Angle exceeds the threshold.
+	Grounded.bRotateL = AimingAngle < Settings.RotateMinThreshold;
+	Grounded.bRotateR = AimingAngle > Settings.RotateMaxThreshold;
+
+	// Step 2: If the character should be rotating, set the Rotate Rate to scale with the Aim Yaw Rate.
+	// This makes the character rotate faster when moving the camera faster.
+	if (Grounded.bRotateL || Grounded.bRotateR)
+	{
+		Grounded.RotateRate = FMath::GetMappedRangeValueClamped(
+			{Settings.AimYawRateMinRange, Settings.AimYawRateMaxRange},
+			{Settings.MinPlayRate, Settings.MaxPlayRate},
+			AimYawRate);
+	}
+}
+
+bool FALSLocomotionCore::TurnInPlaceCheck(float AimingAngle, float AimYawRate, float DeltaTime,
+                                          FALSAnimTurnInPlace& TurnInPlaceValues)
+{
+	// Step 1: Check if Aiming angle is outside of the Turn Check Min Angle, and if the Aim Yaw Rate is below the Aim Yaw Rate Limit.
+	// If so, begin counting the Elapsed Delay Time. If not, reset the Elapsed Delay Time.
+	// This ensures the conditions remain true for a sustained peroid of time before turning in place.
+	if (FMath::Abs(AimingAngle) <= TurnInPlaceValues.TurnCheckMinAngle ||
+		AimYawRate >= TurnInPlaceValues.AimYawRateLimit)
+	{
+		TurnInPlaceValues.ElapsedDelayTime = 0.0f;
+		return false;
+	}
+
+	TurnInPlaceValues.ElapsedDelayTime += DeltaTime;
+	const float ClampedAimAngle = FMath::GetMappedRangeValueClamped(
+		{TurnInPlaceValues.TurnCheckMinAngle, 180.0f},
+		{TurnInPlaceValues.MinAngleDelay, TurnInPlaceValues.MaxAngleDelay},
+		AimingAngle);
+
+	// Step 2: Check if the Elapsed Delay time exceeds the set delay (mapped to the turn angle range). If so, trigger a Turn In Place.
+	return TurnInPlaceValues.ElapsedDelayTime > ClampedAimAngle;
+}
@@ -0,0 +1,126 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSLocomotionSimulation.h"
+
+FALSLocomotionSimulationSettings::FALSLocomotionSimulationSettings()
+{
+	MovementSettings.Standing.WalkSpeed = 165.0f;
+	MovementSettings.Standing.RunSpeed = 350.0f;
+	MovementSettings.Standing.SprintSpeed = 600.0f;
+	MovementSettings.Crouching.WalkSpeed = 150.0f;
+	MovementSettings.Crouching.RunSpeed = 200.0f;
+	MovementSettings.Crouching.SprintSpeed = 300.0f;
+}
+
+FALSLocomotionSimulation::FALSLocomotionSimulation(const FALSLocomotionSimulationSettings& InSettings, int32 Seed)
+	: Settings(InSettings), RandomStream(Seed)
+{
+}
+
+void FALSLocomotionSimulation::AddCharacters(int32 Num)
+{
+	Characters.Reserve(Characters.Num() + Num);
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		FALSSimulatedCharacter& Character = Characters.AddDefaulted_GetRef();
+		Character.Location = FVector(RandomStream.FRandRange(-10000.0f, 10000.0f),
+		                             RandomStream.FRandRange(-10000.0f, 10000.0f), 0.0f);
+		Character.Rotation = FRotator(0.0f, RandomStream.FRandRange(-180.0f, 180.0f), 0.0f);
+		Character.TargetRotation = Character.Rotation;
+		Character.GaitState.AimingRotation = Character.Rotation;
+	}
+}
+
+void FALSLocomotionSimulation::Step(float DeltaTime)
+{
+	for (FALSSimulatedCharacter& Character : Characters)
+	{
+		FALSGaitState& GaitState = Character.GaitState;
+
+		// Step 1: Update the simulated player input and the essential values
+		UpdateInput(Character, DeltaTime);
+		const FALSMovementSettings& MovementSettings = GaitState.Stance == EALSStance::Standing
+			                                               ? Settings.MovementSettings.Standing
+			                                               : Settings.MovementSettings.Crouching;
+		GaitState.Speed = Character.Velocity.Size2D();
+		GaitState.bHasMovementInput = GaitState.MovementInputAmount > 0.0f;
+
+		// Step 2: Select the gait, same as the character movement update
+		const EALSGait AllowedGait = FALSLocomotionCore::GetAllowedGait(GaitState);
+		Character.Gait = FALSLocomotionCore::GetActualGait(GaitState, MovementSettings, AllowedGait);
+
+		// Step 3: Move towards the input direction, limited to the max speed of the allowed gait
+		const float MaxSpeed = MovementSettings.GetSpeedForGait(AllowedGait);
+		const FVector TargetVelocity = GaitState.MovementInput.GetSafeNormal2D() * GaitState.MovementInputAmount
+			* MaxSpeed;
+		const float AccelerationRate = GaitState.bHasMovementInput ? Settings.Acceleration : Settings.Deceleration;
+		Character.Velocity = FMath::VInterpConstantTo(Character.Velocity, TargetVelocity, DeltaTime,
+		                                              AccelerationRate);
+		Character.Location += Character.Velocity * DeltaTime;
+
+		// Step 4: Rotate towards the velocity or the aiming direction, depending on the rotation mode
+		if (GaitState.Speed > 0.0f || GaitState.RotationMode == EALSRotationMode::Aiming)
+		{
+			const float RotationRate = Settings.RotationRate * FALSLocomotionCore::GetMappedSpeed(
+				GaitState.Speed, MovementSettings);
+			const FRotator Target = GaitState.RotationMode == EALSRotationMode::VelocityDirection
+				                        ? FRotator(0.0f, Character.Velocity.ToOrientationRotator().Yaw, 0.0f)
+				                        : FRotator(0.0f, GaitState.AimingRotation.Yaw, 0.0f);
+			Character.Rotation = FALSLocomotionCore::SmoothRotation(Character.Rotation, Character.TargetRotation,
+			                                                        Target, 500.0f, RotationRate, DeltaTime);
+		}
+
+		// Step 5: Animation values, only calculated while moving like the anim instance does
+		Character.VelocityBlend = Character.Velocity.Size2D() > 1.0f
+			                          ? FALSLocomotionCore::CalculateVelocityBlend(
+				                          Character.Velocity, Character.Rotation)
+			                          : FALSVelocityBlend();
+	}
+}
+
+void FALSLocomotionSimulation::Run(float Duration, float StepTime)
+{
+	check(StepTime > 0.0f);
+
+	for (float Time = 0.0f; Time < Duration; Time += StepTime)
+	{
+		Step(StepTime);
+	}
+}
+
+void FALSLocomotionSimulation::UpdateInput(FALSSimulatedCharacter& Character, float DeltaTime)
+{
+	Character.InputChangeTime -= DeltaTime;
+	if (Character.InputChangeTime > 0.0f)
+	{
+		return;
+	}
+
+	Character.InputChangeTime = RandomStream.FRandRange(0.5f, 1.5f) * Settings.InputChangeInterval;
+
+	FALSGaitState& GaitState = Character.GaitState;
+	GaitState.AimingRotation.Yaw = FRotator::NormalizeAxis(
+		GaitState.AimingRotation.Yaw + RandomStream.FRandRange(-90.0f, 90.0f));
+	GaitState.RotationMode = static_cast<EALSRotationMode>(RandomStream.RandHelper(3));
+	GaitState.DesiredGait = static_cast<EALSGait>(RandomStream.RandHelper(3));
+	GaitState.Stance = RandomStream.FRand() < Settings.CrouchChance ? EALSStance::Crouching : EALSStance::Standing;
+
+	// Stand still a quarter of the time, otherwise move relative to the aiming direction
+	if (RandomStream.FRand() < 0.25f)
+	{
+		GaitState.MovementInput = FVector::ZeroVector;
+		GaitState.MovementInputAmount = 0.0f;
+	}
+	else
+	{
+		const float InputYaw = GaitState.AimingRotation.Yaw + RandomStream.FRandRange(-135.0f, 135.0f);
+		GaitState.MovementInput = FRotator(0.0f, InputYaw, 0.0f).Vector();
+		GaitState.MovementInputAmount = RandomStream.FRandRange(0.5f, 1.0f);
+	}
+}
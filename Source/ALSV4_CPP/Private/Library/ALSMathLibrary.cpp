@@ -8,6 +8,7 @@
 
 #include "Library/ALSMathLibrary.h"
 
+#include "Library/ALSStats.h"
 #include "Components/CapsuleComponent.h"
 #include "Library/ALSCharacterStructLibrary.h"
 
@@ -62,8 +63,11 @@ bool UALSMathLibrary::CapsuleHasRoomCheck(UCapsuleComponent* Capsule, FVector Ta
 	Params.AddIgnoredActor(Capsule->GetOwner());
 
 	FHitResult HitResult;
-	World->SweepSingleByProfile(HitResult, TraceStart, TraceEnd, FQuat::Identity,
-	                            FName(TEXT("ALS_Character")), FCollisionShape::MakeSphere(Radius), Params);
+	{
+		ALS_SCOPE_TRACE();
+		World->SweepSingleByProfile(HitResult, TraceStart, TraceEnd, FQuat::Identity,
+		                            FName(TEXT("ALS_Character")), FCollisionShape::MakeSphere(Radius), Params);
+	}
 
 	return !(HitResult.bBlockingHit || HitResult.bStartPenetrating);
 }
@@ -104,3 +108,202 @@ EALSMovementDirection UALSMathLibrary::CalculateQuadrant(EALSMovementDirection C
 
 	return EALSMovementDirection::Backward;
 }
+
+FVector UALSMathLibrary::CalculateAxisIndependentLag(FVector CurrentLocation, FVector TargetLocation,
+                                                     FRotator Rotation, FVector LagSpeeds, float DeltaTime)
+{
+	Rotation.Roll = 0.0f;
+	Rotation.Pitch = 0.0f;
+	const FVector UnrotatedCurLoc = Rotation.UnrotateVector(CurrentLocation);
+	const FVector UnrotatedTargetLoc = Rotation.UnrotateVector(TargetLocation);
+
+	const FVector ResultVector(
+		FMath::FInterpTo(UnrotatedCurLoc.X, UnrotatedTargetLoc.X, DeltaTime, LagSpeeds.X),
+		FMath::FInterpTo(UnrotatedCurLoc.Y, UnrotatedTargetLoc.Y, DeltaTime, LagSpeeds.Y),
+		FMath::FInterpTo(UnrotatedCurLoc.Z, UnrotatedTargetLoc.Z, DeltaTime, LagSpeeds.Z));
+
+	return Rotation.RotateVector(ResultVector);
+}
+
+void UALSMathLibrary::CalculateQuadrants(TArrayView<const float> Angles, float FRThreshold, float FLThreshold,
+                                         float BRThreshold, float BLThreshold, float Buffer,
+                                         TArrayView<EALSMovementDirection> OutDirections)
+{
+	check(Angles.Num() == OutDirections.Num());
+
+	// CalculateQuadrant increases the buffers for every current direction, so the ranges are the same for all angles
+	const VectorRegister ForwardMin = VectorSetFloat1(FLThreshold - Buffer);
+	const VectorRegister ForwardMax = VectorSetFloat1(FRThreshold + Buffer);
+	const VectorRegister RightMin = VectorSetFloat1(FRThreshold - Buffer);
+	const VectorRegister RightMax = VectorSetFloat1(BRThreshold + Buffer);
+	const VectorRegister LeftMin = VectorSetFloat1(BLThreshold - Buffer);
+	const VectorRegister LeftMax = VectorSetFloat1(FLThreshold + Buffer);
+
+	int32 Index = 0;
+	for (; Index + 4 <= Angles.Num(); Index += 4)
+	{
+		const VectorRegister Angle = VectorLoad(&Angles[Index]);
+		const int32 ForwardBits = VectorMaskBits(
+			VectorBitwiseAnd(VectorCompareGE(Angle, ForwardMin), VectorCompareLE(Angle, ForwardMax)));
+		const int32 RightBits = VectorMaskBits(
+			VectorBitwiseAnd(VectorCompareGE(Angle, RightMin), VectorCompareLE(Angle, RightMax)));
+		const int32 LeftBits = VectorMaskBits(
+			VectorBitwiseAnd(VectorCompareGE(Angle, LeftMin), VectorCompareLE(Angle, LeftMax)));
+
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const int32 LaneBit = 1 << Lane;
+			OutDirections[Index + Lane] = ForwardBits & LaneBit
+				                              ? EALSMovementDirection::Forward
+				                              : RightBits & LaneBit
+				                              ? EALSMovementDirection::Right
+				                              : LeftBits & LaneBit
+				                              ? EALSMovementDirection::Left
+				                              : EALSMovementDirection::Backward;
+		}
+	}
+
+	for (; Index < Angles.Num(); ++Index)
+	{
+		OutDirections[Index] = CalculateQuadrant(EALSMovementDirection::Forward, FRThreshold, FLThreshold,
+		                                         BRThreshold, BLThreshold, Buffer, Angles[Index]);
+	}
+}
+
+void UALSMathLibrary::FixDiagonalGamepadValues(TArrayView<float> Y, TArrayView<float> X)
+{
+	check(Y.Num() == X.Num());
+
+	// Same operations as GetMappedRangeValueClamped from {0, 0.6} to {1, 1.2}
+	const VectorRegister InRange = VectorSetFloat1(0.6f);
+	const VectorRegister OutMin = VectorSetFloat1(1.0f);
+	const VectorRegister OutRange = VectorSetFloat1(1.2f - 1.0f);
+	const VectorRegister NegOne = VectorSetFloat1(-1.0f);
+
+	int32 Index = 0;
+	for (; Index + 4 <= Y.Num(); Index += 4)
+	{
+		const VectorRegister ValuesY = VectorLoad(&Y[Index]);
+		const VectorRegister ValuesX = VectorLoad(&X[Index]);
+
+		const VectorRegister PctY = VectorMin(VectorMax(VectorDivide(VectorAbs(ValuesX), InRange), VectorZero()),
+		                                      VectorOne());
+		const VectorRegister PctX = VectorMin(VectorMax(VectorDivide(VectorAbs(ValuesY), InRange), VectorZero()),
+		                                      VectorOne());
+		const VectorRegister ResultY = VectorMultiply(ValuesY, VectorMultiplyAdd(PctY, OutRange, OutMin));
+		const VectorRegister ResultX = VectorMultiply(ValuesX, VectorMultiplyAdd(PctX, OutRange, OutMin));
+
+		VectorStore(VectorMin(VectorMax(ResultY, NegOne), VectorOne()), &Y[Index]);
+		VectorStore(VectorMin(VectorMax(ResultX, NegOne), VectorOne()), &X[Index]);
+	}
+
+	for (; Index < Y.Num(); ++Index)
+	{
+		const TPair<float, float> Result = FixDiagonalGamepadValues(Y[Index], X[Index]);
+		Y[Index] = Result.Key;
+		X[Index] = Result.Value;
+	}
+}
+
+void UALSMathLibrary::CalculateAxisIndependentLag(TArrayView<const FVector> CurrentLocations,
+                                                  TArrayView<const FVector> TargetLocations,
+                                                  TArrayView<const FRotator> Rotations,
+                                                  TArrayView<const FVector> LagSpeeds, float DeltaTime,
+                                                  TArrayView<FVector> OutLocations)
+{
+	const int32 Num = CurrentLocations.Num();
+	check(TargetLocations.Num() == Num && Rotations.Num() == Num && LagSpeeds.Num() == Num &&
+		OutLocations.Num() == Num);
+
+	const VectorRegister DeltaTimes = VectorSetFloat1(DeltaTime);
+	const VectorRegister SmallNumber = VectorSetFloat1(SMALL_NUMBER);
+
+	// Same operations as FMath::FInterpTo on four lanes
+	auto InterpTo = [&](const VectorRegister& Current, const VectorRegister& Target, const VectorRegister& Speed)
+	{
+		const VectorRegister Dist = VectorSubtract(Target, Current);
+		const VectorRegister Alpha = VectorMin(VectorMax(VectorMultiply(DeltaTimes, Speed), VectorZero()),
+		                                       VectorOne());
+		const VectorRegister Result = VectorMultiplyAdd(Dist, Alpha, Current);
+		const VectorRegister UseTarget = VectorBitwiseOr(VectorCompareLE(Speed, VectorZero()),
+		                                                 VectorCompareLT(VectorMultiply(Dist, Dist), SmallNumber));
+		return VectorSelect(UseTarget, Target, Result);
+	};
+
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		// Step 1: Transpose four characters into one register per component
+		MS_ALIGN(16) float Yaw[4] GCC_ALIGN(16);
+		MS_ALIGN(16) float Components[9][4] GCC_ALIGN(16);
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const FVector& Current = CurrentLocations[Index + Lane];
+			const FVector& Target = TargetLocations[Index + Lane];
+			const FVector& Speed = LagSpeeds[Index + Lane];
+			Yaw[Lane] = FMath::DegreesToRadians(Rotations[Index + Lane].Yaw);
+			Components[0][Lane] = Current.X;
+			Components[1][Lane] = Current.Y;
+			Components[2][Lane] = Current.Z;
+			Components[3][Lane] = Target.X;
+			Components[4][Lane] = Target.Y;
+			Components[5][Lane] = Target.Z;
+			Components[6][Lane] = Speed.X;
+			Components[7][Lane] = Speed.Y;
+			Components[8][Lane] = Speed.Z;
+		}
+
+		const VectorRegister Yaws = VectorLoadAligned(Yaw);
+		VectorRegister Sin, Cos;
+		VectorSinCos(&Sin, &Cos, &Yaws);
+
+		// Step 2: Unrotate by the yaw, interpolate each axis and rotate back
+		const VectorRegister CurX = VectorLoadAligned(Components[0]);
+		const VectorRegister CurY = VectorLoadAligned(Components[1]);
+		const VectorRegister TargetX = VectorLoadAligned(Components[3]);
+		const VectorRegister TargetY = VectorLoadAligned(Components[4]);
+
+		const VectorRegister UnrotatedCurX = VectorMultiplyAdd(CurY, Sin, VectorMultiply(CurX, Cos));
+		const VectorRegister UnrotatedCurY = VectorSubtract(VectorMultiply(CurY, Cos), VectorMultiply(CurX, Sin));
+		const VectorRegister UnrotatedTargetX = VectorMultiplyAdd(TargetY, Sin, VectorMultiply(TargetX, Cos));
+		const VectorRegister UnrotatedTargetY = VectorSubtract(VectorMultiply(TargetY, Cos),
+		                                                       VectorMultiply(TargetX, Sin));
+
+		const VectorRegister LagX = InterpTo(UnrotatedCurX, UnrotatedTargetX, VectorLoadAligned(Components[6]));
+		const VectorRegister LagY = InterpTo(UnrotatedCurY, UnrotatedTargetY, VectorLoadAligned(Components[7]));
+		const VectorRegister LagZ = InterpTo(VectorLoadAligned(Components[2]), VectorLoadAligned(Components[5]),
+		                                     VectorLoadAligned(Components[8]));
+
+		VectorStoreAligned(VectorSubtract(VectorMultiply(LagX, Cos), VectorMultiply(LagY, Sin)), Components[0]);
+		VectorStoreAligned(VectorMultiplyAdd(LagX, Sin, VectorMultiply(LagY, Cos)), Components[1]);
+		VectorStoreAligned(LagZ, Components[2]);
+
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			OutLocations[Index + Lane] = FVector(Components[0][Lane], Components[1][Lane], Components[2][Lane]);
+		}
+	}
+
+	for (; Index < Num; ++Index)
+	{
+		OutLocations[Index] = CalculateAxisIndependentLag(CurrentLocations[Index], TargetLocations[Index],
+		                                                  Rotations[Index], LagSpeeds[Index], DeltaTime);
+	}
+}
+
+void UALSMathLibrary::LerpTransforms(TArrayView<const FTransform> A, TArrayView<const FTransform> B,
+                                     TArrayView<const float> Alphas, TArrayView<FTransform> OutTransforms)
+{
+	const int32 Num = A.Num();
+	check(B.Num() == Num && Alphas.Num() == Num && OutTransforms.Num() == Num);
+
+	// FTransform blending already runs on vector registers, one transform at a time
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		FTransform NA = A[Index];
+		FTransform NB = B[Index];
+		NA.NormalizeRotation();
+		NB.NormalizeRotation();
+		OutTransforms[Index].Blend(NA, NB, Alphas[Index]);
+	}
+}
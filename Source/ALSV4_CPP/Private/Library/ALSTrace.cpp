@@ -0,0 +1,69 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSTrace.h"
+
+#if ALS_TRACE_ENABLED
+
+#include "GameFramework/Actor.h"
+
+UE_TRACE_CHANNEL_DEFINE(ALSChannel)
+
+UE_TRACE_EVENT_BEGIN(ALS, StateChange)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, CharacterId)
+	UE_TRACE_EVENT_FIELD(uint8, NetRole)
+	UE_TRACE_EVENT_FIELD(uint8, State)
+	UE_TRACE_EVENT_FIELD(uint8, PrevValue)
+	UE_TRACE_EVENT_FIELD(uint8, NewValue)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(ALS, Mantle)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, CharacterId)
+	UE_TRACE_EVENT_FIELD(uint8, NetRole)
+	UE_TRACE_EVENT_FIELD(uint8, Result)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(ALS, Ragdoll)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, CharacterId)
+	UE_TRACE_EVENT_FIELD(uint8, NetRole)
+	UE_TRACE_EVENT_FIELD(bool, bStart)
+UE_TRACE_EVENT_END()
+
+void FALSTrace::OutputStateChange(const AActor* Character, EALSTraceState State, uint8 PrevValue, uint8 NewValue)
+{
+	UE_TRACE_LOG(ALS, StateChange, ALSChannel)
+		<< StateChange.Cycle(FPlatformTime::Cycles64())
+		<< StateChange.CharacterId(Character->GetUniqueID())
+		<< StateChange.NetRole(static_cast<uint8>(Character->GetLocalRole()))
+		<< StateChange.State(static_cast<uint8>(State))
+		<< StateChange.PrevValue(PrevValue)
+		<< StateChange.NewValue(NewValue);
+}
+
+void FALSTrace::OutputMantle(const AActor* Character, EALSTraceMantleResult Result)
+{
+	UE_TRACE_LOG(ALS, Mantle, ALSChannel)
+		<< Mantle.Cycle(FPlatformTime::Cycles64())
+		<< Mantle.CharacterId(Character->GetUniqueID())
+		<< Mantle.NetRole(static_cast<uint8>(Character->GetLocalRole()))
+		<< Mantle.Result(static_cast<uint8>(Result));
+}
+
+void FALSTrace::OutputRagdoll(const AActor* Character, bool bStart)
+{
+	UE_TRACE_LOG(ALS, Ragdoll, ALSChannel)
+		<< Ragdoll.Cycle(FPlatformTime::Cycles64())
+		<< Ragdoll.CharacterId(Character->GetUniqueID())
+		<< Ragdoll.NetRole(static_cast<uint8>(Character->GetLocalRole()))
+		<< Ragdoll.bStart(bStart);
+}
+
+#endif
@@ -0,0 +1,84 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Benchmark/ALSBenchmarkCommandlet.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSBenchmarkCommandletTest, "ALS.Benchmark.Commandlet",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FALSBenchmarkCommandletTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumCharacters = 4;
+	constexpr int32 NumFrames = 10;
+
+	// Step 1: Run a short benchmark
+	const FString OutputPath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("ALSBenchmarkTest.csv"));
+	IFileManager::Get().Delete(*OutputPath);
+
+	UALSBenchmarkCommandlet* Commandlet = NewObject<UALSBenchmarkCommandlet>();
+	const FString Params = FString::Printf(TEXT("-Characters=%d -Frames=%d -WarmupFrames=2 -Output=\"%s\""),
+	                                       NumCharacters, NumFrames, *OutputPath);
+	if (!TestEqual(TEXT("Benchmark exit code"), Commandlet->Main(Params), 0))
+	{
+		return false;
+	}
+
+	// Step 2: Check the report
+	TArray<FString> Lines;
+	if (!TestTrue(TEXT("Benchmark report written"), FFileHelper::LoadFileToStringArray(Lines, *OutputPath)))
+	{
+		return false;
+	}
+	if (!TestEqual(TEXT("Header and one row per character count"), Lines.Num(), 2))
+	{
+		return false;
+	}
+
+	TArray<FString> Columns;
+	Lines[0].ParseIntoArray(Columns, TEXT(","));
+	TArray<FString> ExpectedColumns = {TEXT("Characters"), TEXT("Spawned"), TEXT("Frames"), TEXT("FrameMs")};
+	for (uint8 Phase = 0; Phase < static_cast<uint8>(EALSBenchmarkPhase::MAX); ++Phase)
+	{
+		const TCHAR* PhaseName = FALSBenchmarkTimers::GetPhaseName(static_cast<EALSBenchmarkPhase>(Phase));
+		ExpectedColumns.Add(FString::Printf(TEXT("%sMs"), PhaseName));
+	}
+	ExpectedColumns.Add(TEXT("MemoryPerCharacterKB"));
+	ExpectedColumns.Add(TEXT("SimulationMs"));
+	if (!TestEqual(TEXT("Report columns"), FString::Join(Columns, TEXT(",")),
+	               FString::Join(ExpectedColumns, TEXT(","))))
+	{
+		return false;
+	}
+
+	TArray<FString> Values;
+	Lines[1].ParseIntoArray(Values, TEXT(","));
+	if (!TestEqual(TEXT("Number of values"), Values.Num(), Columns.Num()))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Characters"), FCString::Atoi(*Values[0]), NumCharacters);
+	TestTrue(TEXT("Spawned"), FCString::Atoi(*Values[1]) > 0 && FCString::Atoi(*Values[1]) <= NumCharacters);
+	TestEqual(TEXT("Frames"), FCString::Atoi(*Values[2]), NumFrames);
+	TestTrue(TEXT("FrameMs"), FCString::Atod(*Values[3]) > 0.0);
+	for (int32 Index = 4; Index < Values.Num(); ++Index)
+	{
+		TestTrue(FString::Printf(TEXT("%s is a valid time or size"), *Columns[Index]),
+		         Values[Index].IsNumeric() && FCString::Atod(*Values[Index]) >= 0.0);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,99 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSLocomotionSimulation.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSLocomotionSimulationTest, "ALS.Locomotion.Simulation",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FALSLocomotionSimulationTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumCharacters = 2000;
+	constexpr int32 NumSteps = 600;
+	constexpr float StepTime = 1.0f / 60.0f;
+
+	const FALSLocomotionSimulationSettings Settings;
+	FALSLocomotionSimulation Simulation(Settings, 42);
+	Simulation.AddCharacters(NumCharacters);
+
+	TArray<EALSGait> PreviousGaits;
+	for (const FALSSimulatedCharacter& Character : Simulation.GetCharacters())
+	{
+		PreviousGaits.Add(Character.Gait);
+	}
+
+	int32 NumGaitTransitions[3][3] = {};
+	int32 NumCrouchingSteps = 0;
+	const float MaxSpeed = Settings.MovementSettings.Standing.SprintSpeed;
+
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		Simulation.Step(StepTime);
+
+		const TArray<FALSSimulatedCharacter>& Characters = Simulation.GetCharacters();
+		for (int32 Index = 0; Index < Characters.Num(); ++Index)
+		{
+			const FALSSimulatedCharacter& Character = Characters[Index];
+			const FALSGaitState& GaitState = Character.GaitState;
+			const EALSGait PreviousGait = PreviousGaits[Index];
+
+			// Only standing characters that don't aim may sprint
+			if (Character.Gait == EALSGait::Sprinting && (GaitState.Stance != EALSStance::Standing ||
+				GaitState.RotationMode == EALSRotationMode::Aiming))
+			{
+				AddError(FString::Printf(TEXT("Character %d sprints at step %d while crouching or aiming"), Index,
+				                         Step));
+				return false;
+			}
+
+			// Acceleration is limited, so the gait can't skip running between two steps
+			if (FMath::Abs(static_cast<int32>(Character.Gait) - static_cast<int32>(PreviousGait)) > 1)
+			{
+				AddError(FString::Printf(TEXT("Character %d changes from %s to %s at step %d"), Index,
+				                         *UEnum::GetValueAsString(PreviousGait),
+				                         *UEnum::GetValueAsString(Character.Gait), Step));
+				return false;
+			}
+
+			if (Character.Velocity.ContainsNaN() || Character.Rotation.ContainsNaN()
+				|| Character.Velocity.Size2D() > MaxSpeed + KINDA_SMALL_NUMBER)
+			{
+				AddError(FString::Printf(TEXT("Character %d has an invalid velocity %s at step %d"), Index,
+				                         *Character.Velocity.ToString(), Step));
+				return false;
+			}
+
+			++NumGaitTransitions[static_cast<uint8>(PreviousGait)][static_cast<uint8>(Character.Gait)];
+			PreviousGaits[Index] = Character.Gait;
+			NumCrouchingSteps += GaitState.Stance == EALSStance::Crouching ? 1 : 0;
+		}
+	}
+
+	// Every gait is entered and left again
+	for (uint8 From = 0; From < 3; ++From)
+	{
+		for (uint8 To = 0; To < 3; ++To)
+		{
+			if (FMath::Abs(From - To) == 1)
+			{
+				TestTrue(FString::Printf(TEXT("Transition from %s to %s"),
+				                         *UEnum::GetValueAsString(static_cast<EALSGait>(From)),
+				                         *UEnum::GetValueAsString(static_cast<EALSGait>(To))),
+				         NumGaitTransitions[From][To] > 0);
+			}
+		}
+	}
+	TestTrue(TEXT("Characters crouch"), NumCrouchingSteps > 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,180 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSMathLibrary.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Not a multiple of four, so the scalar remainder of the batch functions is covered as well */
+	constexpr int32 NumValues = 1027;
+
+	constexpr int32 RandomSeed = 42;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSCalculateQuadrantsTest, "ALS.Math.CalculateQuadrants",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FALSCalculateQuadrantsTest::RunTest(const FString& Parameters)
+{
+	// Random angles, and the angles at and around the bounds of each quadrant
+	FRandomStream Random(RandomSeed);
+	TArray<float> Angles = {
+		-180.0f, -115.0f, -110.0f, -105.0f, -75.0f, -70.0f, -65.0f, 0.0f, 65.0f, 70.0f, 75.0f, 105.0f, 110.0f,
+		115.0f, 180.0f
+	};
+	while (Angles.Num() < NumValues)
+	{
+		Angles.Add(Random.FRandRange(-180.0f, 180.0f));
+	}
+
+	TArray<EALSMovementDirection> Directions;
+	Directions.SetNum(Angles.Num());
+	UALSMathLibrary::CalculateQuadrants(Angles, 70.0f, -70.0f, 110.0f, -110.0f, 5.0f, Directions);
+
+	for (int32 Index = 0; Index < Angles.Num(); ++Index)
+	{
+		for (uint8 Current = 0; Current <= static_cast<uint8>(EALSMovementDirection::Backward); ++Current)
+		{
+			const EALSMovementDirection Expected = UALSMathLibrary::CalculateQuadrant(
+				static_cast<EALSMovementDirection>(Current), 70.0f, -70.0f, 110.0f, -110.0f, 5.0f, Angles[Index]);
+			if (Directions[Index] != Expected)
+			{
+				AddError(FString::Printf(TEXT("Angle %f is %s, expected %s"), Angles[Index],
+				                         *UEnum::GetValueAsString(Directions[Index]),
+				                         *UEnum::GetValueAsString(Expected)));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSFixDiagonalGamepadValuesTest, "ALS.Math.FixDiagonalGamepadValues",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FALSFixDiagonalGamepadValuesTest::RunTest(const FString& Parameters)
+{
+	// Random axis values, and the corners and the bounds of the mapped range
+	FRandomStream Random(RandomSeed);
+	TArray<float> Y = {0.0f, 1.0f, -1.0f, 0.6f, -0.6f, 1.0f};
+	TArray<float> X = {0.0f, 1.0f, 1.0f, 0.6f, 0.6f, 0.0f};
+	while (Y.Num() < NumValues)
+	{
+		Y.Add(Random.FRandRange(-1.0f, 1.0f));
+		X.Add(Random.FRandRange(-1.0f, 1.0f));
+	}
+
+	TArray<float> ResultY = Y;
+	TArray<float> ResultX = X;
+	UALSMathLibrary::FixDiagonalGamepadValues(ResultY, ResultX);
+
+	for (int32 Index = 0; Index < Y.Num(); ++Index)
+	{
+		const TPair<float, float> Expected = UALSMathLibrary::FixDiagonalGamepadValues(Y[Index], X[Index]);
+		if (!FMath::IsNearlyEqual(ResultY[Index], Expected.Key, KINDA_SMALL_NUMBER)
+			|| !FMath::IsNearlyEqual(ResultX[Index], Expected.Value, KINDA_SMALL_NUMBER))
+		{
+			AddError(FString::Printf(TEXT("Values %f, %f are fixed to %f, %f, expected %f, %f"), Y[Index], X[Index],
+			                         ResultY[Index], ResultX[Index], Expected.Key, Expected.Value));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSCalculateAxisIndependentLagTest, "ALS.Math.CalculateAxisIndependentLag",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FALSCalculateAxisIndependentLagTest::RunTest(const FString& Parameters)
+{
+	constexpr float DeltaTime = 1.0f / 60.0f;
+
+	FRandomStream Random(RandomSeed);
+	TArray<FVector> CurrentLocations;
+	TArray<FVector> TargetLocations;
+	TArray<FRotator> Rotations;
+	TArray<FVector> LagSpeeds;
+	for (int32 Index = 0; Index < NumValues; ++Index)
+	{
+		const FVector CurrentLocation = Random.VRand() * Random.FRandRange(0.0f, 10000.0f);
+
+		// Also cover locations that already reached their target, and axes without lag
+		CurrentLocations.Add(CurrentLocation);
+		TargetLocations.Add(Index % 16 == 0 ? CurrentLocation : CurrentLocation + Random.VRand() * 500.0f);
+		Rotations.Add(FRotator(Random.FRandRange(-90.0f, 90.0f), Random.FRandRange(-360.0f, 360.0f),
+		                       Random.FRandRange(-180.0f, 180.0f)));
+		LagSpeeds.Add(FVector(Index % 8 == 0 ? 0.0f : Random.FRandRange(1.0f, 20.0f), Random.FRandRange(1.0f, 20.0f),
+		                      Random.FRandRange(1.0f, 100.0f)));
+	}
+
+	TArray<FVector> Locations;
+	Locations.SetNum(NumValues);
+	UALSMathLibrary::CalculateAxisIndependentLag(CurrentLocations, TargetLocations, Rotations, LagSpeeds, DeltaTime,
+	                                             Locations);
+
+	for (int32 Index = 0; Index < NumValues; ++Index)
+	{
+		const FVector Expected = UALSMathLibrary::CalculateAxisIndependentLag(
+			CurrentLocations[Index], TargetLocations[Index], Rotations[Index], LagSpeeds[Index], DeltaTime);
+
+		// The batch version uses the vectorized sine and cosine, allow for their error relative to the location
+		const float Tolerance = KINDA_SMALL_NUMBER * FMath::Max(1.0f, Expected.GetAbsMax());
+		if (!Locations[Index].Equals(Expected, Tolerance))
+		{
+			AddError(FString::Printf(TEXT("Location %d is %s, expected %s"), Index, *Locations[Index].ToString(),
+			                         *Expected.ToString()));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSLerpTransformsTest, "ALS.Math.LerpTransforms",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FALSLerpTransformsTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Random(RandomSeed);
+	TArray<FTransform> A;
+	TArray<FTransform> B;
+	TArray<float> Alphas;
+	for (int32 Index = 0; Index < NumValues; ++Index)
+	{
+		A.Add(FTransform(FRotator(Random.FRandRange(-90.0f, 90.0f), Random.FRandRange(-180.0f, 180.0f), 0.0f),
+		                 Random.VRand() * 1000.0f, FVector::OneVector));
+		B.Add(FTransform(FRotator(0.0f, Random.FRandRange(-180.0f, 180.0f), Random.FRandRange(-180.0f, 180.0f)),
+		                 Random.VRand() * 1000.0f, FVector::OneVector));
+		Alphas.Add(Random.FRand());
+	}
+
+	TArray<FTransform> Transforms;
+	Transforms.SetNum(NumValues);
+	UALSMathLibrary::LerpTransforms(A, B, Alphas, Transforms);
+
+	for (int32 Index = 0; Index < NumValues; ++Index)
+	{
+		const FTransform Expected = UKismetMathLibrary::TLerp(A[Index], B[Index], Alphas[Index]);
+		if (!Transforms[Index].Equals(Expected, KINDA_SMALL_NUMBER))
+		{
+			AddError(FString::Printf(TEXT("Transform %d is %s, expected %s"), Index, *Transforms[Index].ToString(),
+			                         *Expected.ToString()));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,66 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Benchmark/ALSBenchmarkTimers.h"
+
+#include "ALSBenchmarkCommandlet.generated.h"
+
+class UWorld;
+
+/**
+ * Headless locomotion benchmark. Loads a map, spawns AI characters driven by their behavior tree, runs a fixed
+ * number of frames for each character count and writes the CPU time per phase and memory per character as CSV.
+ * The same number of characters is also run through the headless locomotion simulation, which measures the
+ * locomotion logic alone.
+ * Foot IK runs at full detail, the budget governor and anim sharing are off, unless -FootIKLOD, -Budget or
+ * -AnimSharing is passed.
+ *
+ * UE4Editor-Cmd.exe <Project> -run=ALSBenchmark -nullrhi [-Characters=100,500,1000] [-Frames=600]
+ *     [-WarmupFrames=60] [-DeltaTime=0.0333] [-Map=<package>] [-CharacterClass=<class path>] [-Output=<file>]
+ *     [-FootIKLOD] [-Budget] [-AnimSharing]
+ */
+UCLASS()
+class ALSV4_CPP_API UALSBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UALSBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FBenchmarkResult
+	{
+		int32 NumCharacters = 0;
+
+		int32 NumSpawned = 0;
+
+		double FrameMs = 0.0;
+
+		double PhaseMs[static_cast<uint8>(EALSBenchmarkPhase::MAX)] = {};
+
+		double MemoryPerCharacterKB = 0.0;
+
+		double SimulationMs = 0.0;
+	};
+
+	UWorld* LoadWorld(const FString& MapName) const;
+
+	static void UnloadWorld(UWorld* World);
+
+	bool RunBenchmark(const FString& MapName, UClass* CharacterClass, int32 NumCharacters, int32 NumFrames,
+	                  int32 NumWarmupFrames, float DeltaTime, FBenchmarkResult& OutResult) const;
+
+	/** Milliseconds per frame of the headless locomotion simulation */
+	static double RunSimulation(int32 NumCharacters, int32 NumFrames, float DeltaTime);
+};
@@ -0,0 +1,86 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+/**
+ * Phases of the ALS frame measured by the benchmark
+ */
+enum class EALSBenchmarkPhase : uint8
+{
+	CharacterTick,
+	AnimUpdate,
+	Camera,
+	/** Scene queries, also counted in the phase they are issued from */
+	Traces,
+	MAX
+};
+
+/**
+ * CPU time spent in each phase, summed over all threads. Only measured while enabled by the benchmark or the
+ * budget governor.
+ */
+class ALSV4_CPP_API FALSBenchmarkTimers
+{
+public:
+	static bool IsEnabled() { return bEnabled; }
+
+	static void SetEnabled(bool bNewEnabled) { bEnabled = bNewEnabled; }
+
+	static void Reset();
+
+	static void AddCycles(EALSBenchmarkPhase Phase, uint64 NumCycles)
+	{
+		Cycles[static_cast<uint8>(Phase)].fetch_add(NumCycles, std::memory_order_relaxed);
+	}
+
+	static uint64 GetCycles(EALSBenchmarkPhase Phase)
+	{
+		return Cycles[static_cast<uint8>(Phase)].load(std::memory_order_relaxed);
+	}
+
+	static double GetSeconds(EALSBenchmarkPhase Phase);
+
+	static const TCHAR* GetPhaseName(EALSBenchmarkPhase Phase);
+
+private:
+	static bool bEnabled;
+
+	static std::atomic<uint64> Cycles[static_cast<uint8>(EALSBenchmarkPhase::MAX)];
+};
+
+/**
+ * Adds the time spent in its scope to a benchmark phase
+ */
+class FALSBenchmarkScope
+{
+public:
+	explicit FALSBenchmarkScope(EALSBenchmarkPhase InPhase)
+		: Phase(InPhase), StartCycles(FALSBenchmarkTimers::IsEnabled() ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FALSBenchmarkScope()
+	{
+		if (StartCycles != 0)
+		{
+			FALSBenchmarkTimers::AddCycles(Phase, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+private:
+	EALSBenchmarkPhase Phase;
+
+	uint64 StartCycles;
+};
+
+#define ALS_BENCHMARK_SCOPE(Phase) FALSBenchmarkScope ANONYMOUS_VARIABLE(ALSBenchmarkScope)(EALSBenchmarkPhase::Phase)
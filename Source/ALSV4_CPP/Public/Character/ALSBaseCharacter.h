@@ -10,8 +10,15 @@
 
 #include "CoreMinimal.h"
 #include "Components/TimelineComponent.h"
+#include "Character/ALSBudgetGovernor.h"
+#include "Character/ALSSceneQuerySubsystem.h"
 #include "Library/ALSCharacterEnumLibrary.h"
 #include "Library/ALSCharacterStructLibrary.h"
+#include "Library/ALSBoneCache.h"
+#include "Library/ALSCurveTable.h"
+#include "Library/ALSLandPrediction.h"
+#include "Library/ALSLatch.h"
+#include "Library/ALSLocomotionCore.h"
 #include "Engine/DataTable.h"
 #include "GameFramework/Character.h"
 #include "Kismet/KismetSystemLibrary.h"
@@ -32,6 +39,8 @@ class ALSV4_CPP_API AALSBaseCharacter : public ACharacter
 {
 	GENERATED_BODY()
 
+	friend class UALSCharacterUpdateSubsystem;
+
 public:
 	AALSBaseCharacter(const FObjectInitializer& ObjectInitializer);
 
@@ -41,10 +50,10 @@ public:
 		return MyCharacterMovementComponent;
 	}
 
-	virtual void Tick(float DeltaTime) override;
-
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void PreInitializeComponents() override;
 
 	virtual void Restart() override;
@@ -248,6 +257,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Movement System")
 	bool CanSprint() const;
 
+	/** Seconds until the falling character lands on a walkable surface, negative if no landing is predicted */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Movement System")
+	float GetTimeToLand() const;
+
+	const FALSLandPrediction& GetLandPrediction() const { return LandPrediction; }
+
 	/** BP implementable function that called when Breakfall starts */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "ALS|Movement System")
 	void OnBreakfall();
@@ -329,9 +344,47 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Essential Information")
 	void SetAimYawRate(float NewAimYawRate);
 
+	/** Copy essential information into the anim instance, done once per frame after the character is updated */
+	void PublishAnimCharacterInformation();
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Essential Information")
 	void GetControlForwardRightVector(FVector& Forward, FVector& Right) const;
 
+	/** Dormancy */
+
+	/** Dormant characters don't tick and update their animation at a reduced rate until something wakes them up */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Dormancy")
+	void SetDormant(bool bNewDormant);
+
+	UFUNCTION(BlueprintGetter, Category = "ALS|Dormancy")
+	bool IsDormant() const { return bDormant; }
+
+	/** Quality */
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Quality")
+	EALSQualityTier GetQualityTier() const { return QualityTier; }
+
+	/** Assigned by the budget governor of UALSCharacterUpdateSubsystem */
+	void SetQualityTier(EALSQualityTier NewTier);
+
+	const FALSQualityTierSettings& GetQualitySettings() const { return FALSQualityTierSettings::Get(QualityTier); }
+
+	/** Anim Sharing */
+
+	/**
+	 * Makes the mesh copy the pose of another character instead of evaluating its own animation.
+	 * Assigned by UALSCharacterUpdateSubsystem, nullptr returns to the own animation with a blend.
+	 */
+	void SetAnimSharingLeader(AALSBaseCharacter* NewLeader);
+
+	AALSBaseCharacter* GetAnimSharingLeader() const { return AnimSharingLeader; }
+
+	/** Only plain grounded locomotion looks the same on different characters */
+	bool CanShareAnimation() const;
+
+	/** Characters with the same key play the same animations and can share their pose */
+	uint32 GetAnimSharingKey() const;
+
 protected:
 	/** Ragdoll System */
 
@@ -367,18 +420,38 @@ protected:
 
 	void OnLandFrictionReset();
 
-	void SetEssentialValues(float DeltaTime);
+	/** Fires the latches whose delay has passed */
+	void UpdateLatches();
+
+	bool HasPendingLatches() const
+	{
+		return CameraModeSwapLatch.IsActive() || LandedFrictionResetLatch.IsActive();
+	}
+
+	/**
+	 * Work that runs every frame while the character is awake, even when its state is updated at a reduced rate.
+	 * Called by UALSCharacterUpdateSubsystem after the state update.
+	 */
+	virtual void UpdateFrame();
+
+	/** Movement state dependent update, runs after essential values are set by UALSCharacterUpdateSubsystem */
+	void UpdateCharacterState(float DeltaTime);
 
 	void UpdateCharacterMovement();
 
-	void UpdateDynamicMovementSettingsNetworked(EALSGait AllowedGait);
+	void UpdateDynamicMovementSettingsNetworked();
 
-	void UpdateDynamicMovementSettingsStandalone(EALSGait AllowedGait);
+	void UpdateDynamicMovementSettingsStandalone(bool bMaxSpeedDirty);
 
 	void UpdateGroundedRotation(float DeltaTime);
 
 	void UpdateInAirRotation(float DeltaTime);
 
+	void UpdateLandPrediction();
+
+	/** Mesh tick interval of the current quality tier while awake */
+	float GetMeshTickInterval() const;
+
 	/** Mantle System */
 
 	virtual void MantleStart(float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
@@ -397,6 +470,9 @@ protected:
 
 	float GetMappedSpeed() const;
 
+	/** Values the locomotion core selects the gait from */
+	FALSGaitState GetGaitState() const;
+
 	void SmoothCharacterRotation(FRotator Target, float TargetInterpSpeed, float ActorInterpSpeed, float DeltaTime);
 
 	float CalculateGroundedRotationRate() const;
@@ -563,6 +639,10 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Essential Information")
 	float AimYawRate = 0.0f;
 
+	/** Quadrant of the velocity relative to the aiming rotation, calculated by UALSCharacterUpdateSubsystem */
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Essential Information")
+	EALSMovementDirection MovementDirection = EALSMovementDirection::Forward;
+
 	/** Replicated Essential Information*/
 
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Essential Information")
@@ -602,6 +682,25 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Movement System")
 	FALSMovementStateSettings MovementData;
 
+	/** MovementData flattened by rotation mode and stance, curves are kept alive by MovementData */
+	FALSMovementSettingsTable MovementSettingsTable;
+
+	/** Max walk speed for the current movement settings and MaxSpeedAllowedGait */
+	float TargetMaxSpeed = 0.0f;
+
+	EALSGait MaxSpeedAllowedGait = EALSGait::Walking;
+
+	/** Set when the rotation mode, stance or movement model changes, CurrentMovementSettings needs a refresh */
+	bool bMovementSettingsDirty = true;
+
+	/** Baked tables of the current movement and mantle curves */
+
+	FALSCurveTableHandle MovementCurveTable;
+
+	FALSCurveTableHandle RotationRateCurveTable;
+
+	FALSCurveTableHandle PositionCorrectionCurveTable;
+
 	/** Rotation System */
 
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Rotation System")
@@ -630,6 +729,12 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
 	FTransform MantleAnimatedStartOffset = FTransform::Identity;
 
+	/** Blend in of the mantle timeline, the mantle transform is blended by UALSCharacterUpdateSubsystem */
+	float MantleBlendIn = 0.0f;
+
+	/** True when the mantle timeline advanced since the last batched update */
+	bool bMantleUpdatePending = false;
+
 	/** Breakfall System */
 
 	/** If player hits to the ground with a specified amount of velocity, switch to breakfall state */
@@ -670,12 +775,66 @@ protected:
 	/* Dedicated server mesh default visibility based anim tick option*/
 	EVisibilityBasedAnimTickOption DefVisBasedTickOp;
 
+	/** Dormancy */
+
+	/** Put the character to sleep when it stays idle for a while */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Dormancy")
+	bool bCanBecomeDormant = true;
+
+	/** Mesh tick interval while the character is dormant */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Dormancy", meta = (EditCondition =
+		"bCanBecomeDormant"))
+	float DormantMeshTickInterval = 0.25f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Dormancy")
+	bool bDormant = false;
+
+	/** Time the character has been idle for, used to decide when it becomes dormant */
+	float DormancyIdleTime = 0.0f;
+
+	/* Tick settings to restore when the character wakes up */
+	bool bActorTickEnabledBeforeDormancy = true;
+
+	/** Quality */
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Quality")
+	EALSQualityTier QualityTier = EALSQualityTier::High;
+
+	/** Mesh tick interval at the high quality tier, taken from the mesh when play begins */
+	float BaseMeshTickInterval = 0.0f;
+
+	/** Anim Sharing */
+
+	/** Character whose pose is copied by the mesh, if any */
+	UPROPERTY(Transient)
+	AALSBaseCharacter* AnimSharingLeader = nullptr;
+
 	/** Cached Variables */
 
+	/** Bone indices of the sockets ALS reads from the character mesh */
+	FALSBoneCache BoneCache;
+
+	/** Params of all scene queries issued by the character, ignoring itself */
+	FCollisionQueryParams QueryParams;
+
+	FALSSceneQuery RagdollGroundQuery;
+
+	/** Landing of the current fall, only updated while In Air */
+	FALSLandPrediction LandPrediction;
+
 	FVector PreviousVelocity = FVector::ZeroVector;
 
 	float PreviousAimYaw = 0.0f;
 
+	/** Movement input axes of the player, X forward and Y right. Applied by UALSCharacterUpdateSubsystem. */
+	FVector2D PlayerMovementInputAxes = FVector2D::ZeroVector;
+
+	/** True when the player input axes were set since the last batched movement input */
+	bool bPlayerMovementInputPending = false;
+
+	/** Delta time accumulated since the last update by UALSCharacterUpdateSubsystem */
+	float UpdateAccumulatedDeltaTime = 0.0f;
+
 	UPROPERTY(BlueprintReadOnly)
 	UALSCharacterAnimInstance* MainAnimInstance = nullptr;
 
@@ -685,11 +844,11 @@ protected:
 	/** Last time the camera action button is pressed */
 	float CameraActionPressedTime = 0.0f;
 
-	/* Timer to manage camera mode swap action */
-	FTimerHandle OnCameraModeSwapTimer;
+	/* Latch to manage camera mode swap action */
+	FALSLatch CameraModeSwapLatch;
 
-	/* Timer to manage reset of braking friction factor after on landed event */
-	FTimerHandle OnLandedFrictionResetTimer;
+	/* Latch to manage reset of braking friction factor after on landed event */
+	FALSLatch LandedFrictionResetLatch;
 
 	/* Smooth out aiming by interping control rotation*/
 	FRotator AimingRotation = FRotator::ZeroRotator;
@@ -0,0 +1,86 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+
+/**
+ * Features and update rates of an ALS character at a quality tier
+ */
+struct ALSV4_CPP_API FALSQualityTierSettings
+{
+	/** Traces each foot, otherwise both feet share a single trace */
+	bool bFullFootIK;
+
+	bool bFootIK;
+
+	bool bLandPrediction;
+
+	bool bDynamicTransitions;
+
+	/** Mantle checks while falling. Mantles started by input are always checked. */
+	bool bFallingMantleChecks;
+
+	/** Minimum interval of the batched character update */
+	float UpdateInterval;
+
+	/** Minimum mesh tick interval, which limits the anim update rate */
+	float MeshTickInterval;
+
+	static const FALSQualityTierSettings& Get(EALSQualityTier Tier);
+};
+
+/**
+ * Closed loop controller keeping the CPU time of all ALS characters within a per frame budget (ALS.Budget.Ms).
+ * Measures the ALS cost of the past frames, lowers quality tiers while over budget and raises them again while
+ * below the headroom. Lowered tiers are taken from the least significant characters first.
+ */
+class ALSV4_CPP_API FALSBudgetGovernor
+{
+public:
+	static bool IsEnabled();
+
+	/**
+	 * Adds the ALS cost of the last frame. Returns true when the governor re-evaluated the budget and the
+	 * characters need to be assigned their tiers again. NumCharacters only counts the characters whose tier
+	 * may be lowered.
+	 */
+	bool Update(float DeltaTime, int32 NumCharacters);
+
+	/** Tier of a governed character by its rank, zero being the least significant character */
+	EALSQualityTier GetTier(int32 Rank) const;
+
+	/** Average ALS CPU time per frame over the last evaluation interval */
+	float GetCostMs() const { return CostMs; }
+
+	/** Number of tiers taken from the characters in total */
+	int32 GetLoweredTiers() const { return LoweredTiers; }
+
+	void Reset();
+
+private:
+	uint64 LastCycles = 0;
+
+	uint64 IntervalCycles = 0;
+
+	int32 IntervalFrames = 0;
+
+	float IntervalTime = 0.0f;
+
+	float CostMs = 0.0f;
+
+	int32 LoweredTiers = 0;
+
+	/** False until the first sample after a reset, which only sets LastCycles */
+	bool bMeasuring = false;
+
+	/** True if the timers were enabled by the governor and not by the benchmark */
+	bool bEnabledTimers = false;
+};
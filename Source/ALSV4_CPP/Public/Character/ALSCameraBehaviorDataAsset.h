@@ -0,0 +1,86 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
+
+#include "ALSCameraBehaviorDataAsset.generated.h"
+
+/**
+ * Camera behavior params for a set of character states. Empty state lists match any state.
+ */
+USTRUCT(BlueprintType)
+struct FALSCameraBehaviorEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conditions")
+	TArray<EALSViewMode> ViewModes;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conditions")
+	TArray<EALSRotationMode> RotationModes;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conditions")
+	TArray<EALSMovementState> MovementStates;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conditions")
+	TArray<EALSMovementAction> MovementActions;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conditions")
+	TArray<EALSGait> Gaits;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conditions")
+	TArray<EALSStance> Stances;
+
+	/** Params for the right shoulder */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Behavior")
+	FALSCameraBehaviorParams Params;
+
+	/** Flip the side offsets for the left shoulder */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Behavior")
+	bool bMirrorLeftShoulder = true;
+
+	/** Crossfade time when the camera switches to this entry */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Behavior", Meta = (ClampMin = "0"))
+	float BlendInTime = 0.5f;
+};
+
+/**
+ * Native replacement of the camera behavior anim graph. The camera manager picks the first entry matching the state
+ * of the controlled character and crossfades between entries, without a camera behavior mesh to tick and evaluate.
+ */
+UCLASS(BlueprintType)
+class ALSV4_CPP_API UALSCameraBehaviorDataAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Checked in order, put specific entries before general ones */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Behavior")
+	TArray<FALSCameraBehaviorEntry> Entries;
+
+	/** Used while no entry matches */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Behavior")
+	FALSCameraBehaviorParams DefaultParams;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Behavior", Meta = (ClampMin = "0"))
+	float DefaultBlendInTime = 0.5f;
+
+	/** Index of the first entry matching the state, INDEX_NONE if none matches */
+	int32 FindEntry(EALSViewMode ViewMode, EALSRotationMode RotationMode, EALSMovementState MovementState,
+	                EALSMovementAction MovementAction, EALSGait Gait, EALSStance Stance) const;
+
+	/** Params of an entry, or the default params for INDEX_NONE */
+	FALSCameraBehaviorParams GetParams(int32 EntryIndex, bool bRightShoulder) const;
+
+	float GetBlendInTime(int32 EntryIndex) const;
+};
@@ -0,0 +1,50 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Library/ALSCharacterStructLibrary.h"
+
+class AALSBaseCharacter;
+class UALSCameraBehaviorDataAsset;
+
+/**
+ * Evaluates the camera behavior params of a character from a camera behavior data asset. Crossfades from the
+ * current params whenever the matching entry or the shoulder changes, like the transitions of the anim graph did.
+ */
+class ALSV4_CPP_API FALSCameraBehaviorEvaluator
+{
+public:
+	const FALSCameraBehaviorParams& Update(const UALSCameraBehaviorDataAsset& Data, const AALSBaseCharacter& Character,
+	                                       bool bRightShoulder, float DeltaTime);
+
+	const FALSCameraBehaviorParams& GetParams() const { return Params; }
+
+	/** The next update starts at the params of the character state, without a blend */
+	void Reset() { bInitialized = false; }
+
+	static FALSCameraBehaviorParams Blend(const FALSCameraBehaviorParams& A, const FALSCameraBehaviorParams& B,
+	                                      float Alpha);
+
+private:
+	FALSCameraBehaviorParams Params;
+
+	/** Params at the start of the current blend */
+	FALSCameraBehaviorParams SourceParams;
+
+	int32 TargetEntryIndex = INDEX_NONE;
+
+	bool bTargetRightShoulder = true;
+
+	float BlendTime = 0.0f;
+
+	float BlendDuration = 0.0f;
+
+	bool bInitialized = false;
+};
@@ -45,7 +45,7 @@ public:
 	virtual FVector GetFirstPersonCameraTarget() override;
 
 protected:
-	virtual void Tick(float DeltaTime) override;
+	virtual void UpdateFrame() override;
 
 	virtual void BeginPlay() override;
 
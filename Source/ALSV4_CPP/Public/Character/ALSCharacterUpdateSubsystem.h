@@ -0,0 +1,266 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Character/ALSBudgetGovernor.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+
+#include "ALSCharacterUpdateSubsystem.generated.h"
+
+class AALSBaseCharacter;
+class APlayerController;
+class UALSCharacterUpdateSubsystem;
+
+/**
+ * Structure of arrays copy of the hot state of all registered characters.
+ * Gathered from the characters once per frame, updated in place, and written back.
+ */
+struct FALSCharacterHotState
+{
+	/** Inputs gathered from the character and its movement component */
+
+	TArray<float> DeltaTime;
+
+	TArray<FVector> Velocity;
+
+	TArray<FVector> PreviousVelocity;
+
+	TArray<FVector> CurrentAcceleration;
+
+	TArray<FRotator> ControlRotation;
+
+	TArray<float> MaxAcceleration;
+
+	TArray<float> PreviousAimYaw;
+
+	TArray<bool> bSimulatedProxy;
+
+	TArray<bool> bLocallyControlled;
+
+	TArray<EALSMovementState> MovementState;
+
+	/** Values carried over between updates and written back to the character */
+
+	TArray<FRotator> AimingRotation;
+
+	TArray<FRotator> LastVelocityRotation;
+
+	TArray<FRotator> LastMovementInputRotation;
+
+	TArray<FVector> Acceleration;
+
+	TArray<float> EasedMaxAcceleration;
+
+	TArray<float> Speed;
+
+	TArray<float> MovementInputAmount;
+
+	TArray<float> AimYawRate;
+
+	TArray<bool> bIsMoving;
+
+	TArray<bool> bHasMovementInput;
+
+	/** Yaw of the velocity relative to the aiming rotation */
+	TArray<float> VelocityYawOffset;
+
+	TArray<EALSMovementDirection> MovementDirection;
+
+	int32 Num() const { return DeltaTime.Num(); }
+
+	void SetNum(int32 NewNum);
+
+	/** Calculates the essential values of a single character. Doesn't touch any engine object. */
+	void SetEssentialValues(int32 Index);
+};
+
+/**
+ * Transforms blended to move the characters that are mantling, in the order of the mantle steps
+ */
+struct FALSMantleBatch
+{
+	TArray<FTransform> Target;
+
+	TArray<FTransform> ActualStartOffset;
+
+	TArray<FTransform> HorizontalTarget;
+
+	TArray<FTransform> VerticalTarget;
+
+	TArray<float> XYCorrectionAlpha;
+
+	TArray<float> ZCorrectionAlpha;
+
+	TArray<FTransform> HorizontalResult;
+
+	TArray<FTransform> VerticalResult;
+
+	TArray<FTransform> CorrectedStart;
+
+	TArray<float> PositionAlpha;
+
+	TArray<FTransform> PositionResult;
+
+	TArray<FTransform> ActualStart;
+
+	TArray<float> BlendIn;
+
+	TArray<FTransform> LerpedTarget;
+
+	void SetNum(int32 NewNum);
+};
+
+/**
+ * Tick function that runs the batched character update
+ */
+struct FALSCharacterUpdateTickFunction : public FTickFunction
+{
+	FALSCharacterUpdateTickFunction();
+
+	UALSCharacterUpdateSubsystem* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+};
+
+/**
+ * Tick function that applies the movement input of all players, after their controllers processed the input
+ * and before their characters move
+ */
+struct FALSPlayerMovementInputTickFunction : public FTickFunction
+{
+	FALSPlayerMovementInputTickFunction();
+
+	UALSCharacterUpdateSubsystem* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+};
+
+/**
+ * Owns all ALS characters of a world and updates their essential values, movement and rotation in one pass,
+ * instead of doing it separately inside each character's tick. Characters far away from all player view points
+ * are updated at a reduced rate, idle characters are not updated until they wake up. While ALS exceeds its CPU
+ * budget, the least significant characters are moved to lower quality tiers. Distant characters in the same state
+ * copy the pose of a few leader characters instead of evaluating their own animation. The movement input of players
+ * and the mantle transforms are processed in batches as well.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSCharacterUpdateSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterCharacter(AALSBaseCharacter* Character);
+
+	void UnregisterCharacter(AALSBaseCharacter* Character);
+
+	/** Makes sure the movement input of players is applied after the player controller processed the input */
+	void AddPlayerController(APlayerController* PlayerController);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Character Update")
+	int32 GetNumCharacters() const { return Characters.Num(); }
+
+	/** Update all registered characters. Called by the update tick function after character movement. */
+	void UpdateCharacters(float DeltaTime);
+
+	/** Apply the movement input of all players. Called by the movement input tick function before movement. */
+	void ApplyPlayerMovementInput();
+
+private:
+	void GatherViewLocations();
+
+	/** Lets the budget governor measure the last frame, and assigns the quality tiers when it re-evaluated them */
+	void UpdateQualityTiers(float DeltaTime);
+
+	/** Releases followers that no longer match their leader, and regroups the characters at a fixed interval */
+	void UpdateAnimSharing(float DeltaTime);
+
+	/** Groups the distant characters by their anim sharing key and assigns the leaders of each group */
+	void AssignAnimSharingLeaders();
+
+	void ReleaseAnimSharingFollowers(const AALSBaseCharacter* Leader);
+
+	void GatherUpdatedCharacters(float DeltaTime);
+
+	float GetViewDistanceSquared(const AALSBaseCharacter* Character) const;
+
+	/** Significance based update interval, zero means the character is updated every frame */
+	float GetUpdateInterval(const AALSBaseCharacter* Character) const;
+
+	/** Puts characters that stay idle long enough to sleep */
+	void UpdateDormancy(AALSBaseCharacter* Character, float DeltaTime) const;
+
+	bool ShouldWakeUp(const AALSBaseCharacter* Character) const;
+
+	void GatherHotState();
+
+	void CommitHotState(int32 Index);
+
+	/** Blends the mantle transforms of all characters whose mantle timeline advanced */
+	void UpdateMantles();
+
+	UPROPERTY(Transient)
+	TArray<AALSBaseCharacter*> Characters;
+
+	/** Characters that are updated this frame, hot state indices map into this array */
+	UPROPERTY(Transient)
+	TArray<AALSBaseCharacter*> UpdatedCharacters;
+
+	/** View points of all players, used to determine the significance of characters */
+	TArray<FVector> ViewLocations;
+
+	FALSCharacterHotState HotState;
+
+	/** Characters whose mantle timeline advanced this frame, mantle batch indices map into this array */
+	UPROPERTY(Transient)
+	TArray<AALSBaseCharacter*> MantlingCharacters;
+
+	FALSMantleBatch MantleBatch;
+
+	/** Characters with player movement input this frame, and their input axes */
+	UPROPERTY(Transient)
+	TArray<AALSBaseCharacter*> InputCharacters;
+
+	TArray<float> InputForward;
+
+	TArray<float> InputRight;
+
+	FALSCharacterUpdateTickFunction UpdateTickFunction;
+
+	FALSPlayerMovementInputTickFunction MovementInputTickFunction;
+
+	FALSBudgetGovernor BudgetGovernor;
+
+	/** Number of characters at each quality tier, as of the last assignment */
+	int32 NumCharactersPerTier[static_cast<uint8>(EALSQualityTier::Minimal) + 1] = {};
+
+	/** True while the quality tiers are assigned by the budget governor */
+	bool bQualityTiersAssigned = false;
+
+	/** Characters whose pose is copied by other characters */
+	TSet<const AALSBaseCharacter*> AnimSharingLeaders;
+
+	int32 NumAnimSharingFollowers = 0;
+
+	/** Time since the characters were last grouped for anim sharing */
+	float AnimSharingTime = 0.0f;
+
+	/** True while UpdateCharacters is iterating over the registered characters */
+	bool bUpdatingCharacters = false;
+};
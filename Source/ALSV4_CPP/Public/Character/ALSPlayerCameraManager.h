@@ -10,9 +10,13 @@
 
 #include "CoreMinimal.h"
 #include "Camera/PlayerCameraManager.h"
+#include "Character/ALSCameraBehaviorEvaluator.h"
+#include "Character/ALSSceneQuerySubsystem.h"
+#include "Library/ALSCharacterStructLibrary.h"
 #include "ALSPlayerCameraManager.generated.h"
 
 class AALSBaseCharacter;
+class UALSCameraBehaviorDataAsset;
 
 /**
  * Player camera manager class
@@ -25,6 +29,8 @@ class ALSV4_CPP_API AALSPlayerCameraManager : public APlayerCameraManager
 public:
 	AALSPlayerCameraManager();
 
+	virtual void PostInitializeComponents() override;
+
 	UFUNCTION(BlueprintCallable)
 	void OnPossess(AALSBaseCharacter* NewCharacter);
 
@@ -49,9 +55,14 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
 	AALSBaseCharacter* ControlledCharacter = nullptr;
 
+	/** Runs the camera behavior anim graph. Destroyed when play begins if CameraBehaviorData is set. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
 	USkeletalMeshComponent* CameraBehavior = nullptr;
 
+	/** If set, the camera behavior params are evaluated natively from this asset instead of the anim graph */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	UALSCameraBehaviorDataAsset* CameraBehaviorData = nullptr;
+
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	FVector RootLocation;
@@ -73,4 +84,12 @@ protected:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
 	FVector DebugViewOffset;
+
+	/** Camera behavior curve values of the current update */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FALSCameraBehaviorParams CameraParams;
+
+	FALSCameraBehaviorEvaluator CameraBehaviorEvaluator;
+
+	FALSSceneQuery CameraCollisionQuery;
 };
@@ -0,0 +1,76 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+
+#include "ALSSceneQuerySubsystem.generated.h"
+
+/**
+ * Systems issuing scene queries every frame, each with its own latency tolerance
+ */
+enum class EALSSceneQuerySystem : uint8
+{
+	FootIK,
+	Ragdoll,
+	Camera,
+	MAX
+};
+
+/**
+ * Scene query a consumer issues every frame. Owned by the consumer, filled by UALSSceneQuerySubsystem.
+ */
+struct FALSSceneQuery
+{
+	/** Latest result, an empty hit result until the first query finished */
+	FHitResult Hit;
+
+	/** Pending async query */
+	FTraceHandle Handle;
+
+	/** Frame the latest query was issued on */
+	uint64 RequestFrame = 0;
+
+	/** Frame the query of the latest result was issued on */
+	uint64 ResultFrame = 0;
+
+	bool bHasResult = false;
+};
+
+/**
+ * Schedules the recurring scene queries of all ALS characters. Queries of systems that tolerate latency are issued as
+ * async queries, which the engine runs as one batch on worker threads at the end of the frame, and their results are
+ * delivered on the next frame. Queries of systems without latency tolerance, and of consumers that do not issue their
+ * query often enough to stay within the tolerated latency, are run right away.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSSceneQuerySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	const FHitResult& LineTraceSingleByChannel(FALSSceneQuery& Query, EALSSceneQuerySystem System,
+	                                           const FVector& Start, const FVector& End,
+	                                           ECollisionChannel TraceChannel, const FCollisionQueryParams& Params);
+
+	const FHitResult& SweepSingleByChannel(FALSSceneQuery& Query, EALSSceneQuerySystem System,
+	                                       const FVector& Start, const FVector& End, ECollisionChannel TraceChannel,
+	                                       const FCollisionShape& Shape, const FCollisionQueryParams& Params);
+
+	const FHitResult& SweepSingleByProfile(FALSSceneQuery& Query, EALSSceneQuerySystem System,
+	                                       const FVector& Start, const FVector& End, FName ProfileName,
+	                                       const FCollisionShape& Shape, const FCollisionQueryParams& Params);
+
+	/** Number of frames the results of a system may lag behind, zero if its queries are run right away */
+	static int32 GetMaxLatency(EALSSceneQuerySystem System);
+};
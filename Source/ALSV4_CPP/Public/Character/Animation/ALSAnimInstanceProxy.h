@@ -0,0 +1,44 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstanceProxy.h"
+
+#include "ALSAnimInstanceProxy.generated.h"
+
+class UALSCharacterAnimInstance;
+
+/**
+ * Runs the thread safe part of the ALS anim update. Update is called on an animation worker thread when multi threaded
+ * animation update is enabled, and on the game thread otherwise.
+ */
+USTRUCT()
+struct ALSV4_CPP_API FALSAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FALSAnimInstanceProxy() = default;
+
+	explicit FALSAnimInstanceProxy(UAnimInstance* InAnimInstance)
+		: FAnimInstanceProxy(InAnimInstance)
+	{
+	}
+
+protected:
+	virtual void Initialize(UAnimInstance* InAnimInstance) override;
+
+	virtual void Update(float DeltaSeconds) override;
+
+	virtual void PostUpdate(UAnimInstance* InAnimInstance) const override;
+
+private:
+	UALSCharacterAnimInstance* ALSAnimInstance = nullptr;
+};
@@ -10,7 +10,15 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "Animation/PoseSnapshot.h"
+#include "Character/ALSSceneQuerySubsystem.h"
 #include "Library/ALSAnimationStructLibrary.h"
+#include "Library/ALSAnimCurveRegistry.h"
+#include "Library/ALSBoneCache.h"
+#include "Library/ALSCurveTable.h"
+#include "Library/ALSDynamicMontagePool.h"
+#include "Library/ALSFootIKTraceCache.h"
+#include "Library/ALSLatch.h"
 #include "Library/ALSStructEnumLibrary.h"
 
 #include "ALSCharacterAnimInstance.generated.h"
@@ -20,6 +28,19 @@ class UCurveFloat;
 class UAnimSequence;
 class UCurveVector;
 
+/**
+ * Foot IK detail levels, picked from the mesh LOD the engine predicts from the screen size of the character
+ */
+enum class EALSFootIKLOD : uint8
+{
+	/** One trace per foot */
+	Full,
+	/** Both feet are placed on the floor plane of a single trace below the pelvis */
+	Plane,
+	/** No traces, the foot locks and offsets blend out */
+	Off
+};
+
 /**
  * Main anim instance class for character
  */
@@ -28,11 +49,16 @@ class ALSV4_CPP_API UALSCharacterAnimInstance : public UAnimInstance
 {
 	GENERATED_BODY()
 
+	friend struct FALSAnimInstanceProxy;
+
 public:
 	virtual void NativeInitializeAnimation() override;
 
+	/** Game thread part of the update, everything that reads the world, the character or the mesh */
 	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
 
+	virtual void NativePostEvaluateAnimation() override;
+
 	UFUNCTION(BlueprintCallable)
 	void PlayTransition(const FALSDynamicMontageParams& Parameters);
 
@@ -90,13 +116,34 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Grounded")
 	bool CanDynamicTransition() const;
 
-	/** Return mutable reference of character information to edit them easily inside character class */
-	FALSAnimCharacterInformation& GetCharacterInformationMutable()
-	{
-		return CharacterInformation;
-	}
+	/**
+	 * Called by the owning character after each of its updates. The next animation update copies the latest
+	 * information and reads nothing else from the character, apart from the walkable checks of the foot IK traces.
+	 */
+	void PublishCharacterInformation(const FALSAnimCharacterInformation& NewCharacterInformation);
+
+	/** Values of ALS curves from the last evaluated pose */
+	const FALSAnimCurveValues& GetCurveValues() const { return CurveValues; }
+
+	/**
+	 * Called when the character stops copying the pose of an anim sharing leader. Keeps the last copied pose,
+	 * which the anim graph blends out of over SharedPoseBlendOutTime.
+	 */
+	void BeginSharedPoseBlendOut(UAnimInstance& LeaderAnimInstance);
+
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
 
 private:
+	/** Thread safe part of the update, only reads the values gathered by NativeUpdateAnimation */
+	void ThreadSafeUpdateAnimation(float DeltaSeconds);
+
+	/** Plays the montages requested by the thread safe update, on the game thread */
+	void PostThreadSafeUpdateAnimation();
+
+	/** Fires the latches whose delay has passed */
+	void UpdateLatches();
+
 	void PlayDynamicTransitionDelay();
 
 	void OnJumpedDelay();
@@ -121,8 +168,8 @@ private:
 
 	/** Foot IK */
 
-	void SetFootLocking(float DeltaSeconds, FName EnableFootIKCurve, FName FootLockCurve, FName IKFootBone,
-	                    float& CurFootLockAlpha, bool& UseFootLockCurve,
+	void SetFootLocking(float DeltaSeconds, EALSAnimCurve EnableFootIKCurve, EALSAnimCurve FootLockCurve,
+	                    EALSBoneSocket IKFootBone, float& CurFootLockAlpha, bool& UseFootLockCurve,
 	                    FVector& CurFootLockLoc, FRotator& CurFootLockRot);
 
 	void SetFootLockOffsets(float DeltaSeconds, FVector& LocalLoc, FRotator& LocalRot);
@@ -131,8 +178,17 @@ private:
 
 	void ResetIKOffsets(float DeltaSeconds);
 
-	void SetFootOffsets(float DeltaSeconds, FName EnableFootIKCurve, FName IKFootBone, FName RootBone,
-	                    FVector& CurLocationTarget, FVector& CurLocationOffset, FRotator& CurRotationOffset);
+	void ResetFootLocking(float DeltaSeconds);
+
+	EALSFootIKLOD CalculateFootIKLOD() const;
+
+	FALSFootIKTraceCache& GetFootIKTraceCache(EALSBoneSocket IKFootBone);
+
+	void TraceFootIKFloor(FALSSceneQuery& Query, FALSFootIKTraceCache& TraceCache, const FVector& FloorLocation);
+
+	void SetFootOffsets(float DeltaSeconds, EALSAnimCurve EnableFootIKCurve, EALSBoneSocket IKFootBone,
+	                    EALSBoneSocket RootBone, FVector& CurLocationTarget, FVector& CurLocationOffset,
+	                    FRotator& CurRotationOffset);
 
 	/** Grounded */
 
@@ -168,7 +224,11 @@ private:
 
 	/** Util */
 
-	float GetAnimCurveClamped(const FName& Name, float Bias, float ClampMin, float ClampMax) const;
+	float GetAnimCurveClamped(EALSAnimCurve Curve, float Bias, float ClampMin, float ClampMax) const;
+
+	/** Same as PlaySlotAnimationAsDynamicMontage, but reuses the montage built for earlier plays */
+	void PlayPooledSlotAnimation(UAnimSequenceBase* Animation, FName SlotName, float BlendInTime, float BlendOutTime,
+	                             float PlayRate, float StartTime);
 
 protected:
 	/** References */
@@ -179,6 +239,44 @@ protected:
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Read Only Data|Character Information", Meta = (
 		ShowOnlyInnerProperties))
 	FALSAnimCharacterInformation CharacterInformation;
+
+	/**
+	 * Character information last published by the character. Written and read on the game thread, the batched
+	 * character update publishes before the mesh ticks.
+	 */
+	FALSAnimCharacterInformation PublishedCharacterInformation;
+
+	FALSAnimCurveRegistry CurveRegistry;
+
+	FALSAnimCurveValues CurveValues;
+
+	FALSBoneCache BoneCache;
+
+	/** Recurring scene queries, the params ignore the character */
+	FCollisionQueryParams QueryParams;
+
+	FALSSceneQuery FootIKQuery_L;
+
+	FALSSceneQuery FootIKQuery_R;
+
+	/** Last walkable foot IK hits */
+	FALSFootIKTraceCache FootIKTraceCache_L;
+
+	FALSFootIKTraceCache FootIKTraceCache_R;
+
+	/** Floor below the pelvis, shared by both feet at the Plane foot IK LOD */
+	FALSSceneQuery FootIKQuery_Pelvis;
+
+	FALSFootIKTraceCache FootIKTraceCache_Pelvis;
+
+	EALSFootIKLOD FootIKLOD = EALSFootIKLOD::Full;
+
+	/** Values read on the game thread for the thread safe update */
+	float MeshScaleZ = 1.0f;
+
+	bool bRunThreadSafeUpdate = false;
+
+	bool bPendingTurnInPlace = false;
 public:
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Read Only Data|Character Information")
 	FALSMovementState MovementState = EALSMovementState::None;
@@ -245,6 +343,16 @@ protected:
 		ShowOnlyInnerProperties))
 	FALSAnimGraphFootIK FootIKValues;
 
+	/** Anim Graph - Anim Sharing */
+
+	/** Last pose copied from the anim sharing leader, feeds a Pose Snapshot node */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Read Only Data|Anim Graph - Anim Sharing")
+	FPoseSnapshot SharedPoseSnapshot;
+
+	/** Weight of SharedPoseSnapshot over the own pose */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Read Only Data|Anim Graph - Anim Sharing")
+	float SharedPoseBlendAlpha = 0.0f;
+
 	/** Turn In Place */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Turn In Place", Meta = (
 		ShowOnlyInnerProperties))
@@ -286,6 +394,24 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Blend Curves")
 	UCurveVector* YawOffset_LR = nullptr;
 
+	/** Baked tables of the blend curves */
+
+	FALSCurveTableHandle DiagonalScaleAmountTable;
+
+	FALSCurveTableHandle StrideBlend_N_WalkTable;
+
+	FALSCurveTableHandle StrideBlend_N_RunTable;
+
+	FALSCurveTableHandle StrideBlend_C_WalkTable;
+
+	FALSCurveTableHandle LandPredictionTable;
+
+	FALSCurveTableHandle LeanInAirTable;
+
+	FALSCurveTableHandle YawOffset_FBTable;
+
+	FALSCurveTableHandle YawOffset_LRTable;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Dynamic Transition")
 	UAnimSequenceBase* TransitionAnim_R = nullptr;
 
@@ -293,11 +419,14 @@ protected:
 	UAnimSequenceBase* TransitionAnim_L = nullptr;
 
 private:
-	FTimerHandle OnPivotTimer;
+	FALSLatch OnPivotLatch;
 
-	FTimerHandle PlayDynamicTransitionTimer;
+	FALSLatch PlayDynamicTransitionLatch;
 
-	FTimerHandle OnJumpedTimer;
+	FALSLatch OnJumpedLatch;
 
 	bool bCanPlayDynamicTransition = true;
+
+	UPROPERTY(Transient)
+	FALSDynamicMontagePool MontagePool;
 };
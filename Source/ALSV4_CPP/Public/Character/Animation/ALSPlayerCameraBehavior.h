@@ -11,6 +11,7 @@
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
 #include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
 
 #include "ALSPlayerCameraBehavior.generated.h"
 
@@ -32,6 +33,9 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	APlayerController* PlayerController = nullptr;
 
+	/** Read all camera behavior curves in one pass */
+	void GetCameraBehaviorParams(FALSCameraBehaviorParams& OutParams) const;
+
 protected:
 	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
 
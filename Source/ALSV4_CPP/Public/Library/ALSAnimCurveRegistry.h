@@ -0,0 +1,81 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UAnimInstance;
+class USkeleton;
+
+/**
+ * Animation curves read by native ALS code
+ */
+enum class EALSAnimCurve : uint8
+{
+	Enable_Transition,
+	Mask_AimOffset,
+	BasePose_N,
+	BasePose_CLF,
+	Layering_Spine_Add,
+	Layering_Head_Add,
+	Layering_Arm_L_Add,
+	Layering_Arm_R_Add,
+	Layering_Hand_R,
+	Layering_Hand_L,
+	Layering_Arm_L,
+	Layering_Arm_R,
+	Layering_Arm_L_LS,
+	Layering_Arm_R_LS,
+	Enable_HandIK_L,
+	Enable_HandIK_R,
+	Enable_FootIK_L,
+	Enable_FootIK_R,
+	FootLock_L,
+	FootLock_R,
+	RotationAmount,
+	YawOffset,
+	W_Gait,
+	Mask_LandPrediction,
+	Mask_FootstepSound,
+	MAX
+};
+
+/**
+ * Values of all ALS curves, filled in one pass after the animation is evaluated
+ */
+struct FALSAnimCurveValues
+{
+	float Values[static_cast<uint8>(EALSAnimCurve::MAX)] = {};
+
+	float Get(EALSAnimCurve Curve) const { return Values[static_cast<uint8>(Curve)]; }
+};
+
+/**
+ * Resolves the ALS curves which exist in the skeleton once, and reads all of them in a single pass
+ */
+class ALSV4_CPP_API FALSAnimCurveRegistry
+{
+public:
+	static const FName& GetCurveName(EALSAnimCurve Curve);
+
+	void Initialize(const USkeleton* NewSkeleton);
+
+	bool IsInitializedFor(const USkeleton* InSkeleton) const { return bInitialized && Skeleton.Get() == InSkeleton; }
+
+	/** Fill the values of all curves. Curves which don't exist in the skeleton are skipped and read as zero. */
+	void ReadCurveValues(const UAnimInstance& AnimInstance, FALSAnimCurveValues& OutValues) const;
+
+private:
+	TWeakObjectPtr<const USkeleton> Skeleton;
+
+	/** Names of the ALS curves which exist in the skeleton */
+	TArray<TPair<FName, EALSAnimCurve>, TInlineAllocator<static_cast<uint8>(EALSAnimCurve::MAX)>> SkeletonCurves;
+
+	bool bInitialized = false;
+};
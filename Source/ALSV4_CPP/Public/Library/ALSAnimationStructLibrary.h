@@ -126,6 +126,10 @@ struct FALSAnimCharacterInformation
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
 	float AimYawRate = 0.0f;
 
+	/** Quadrant of the velocity relative to the aiming rotation */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	EALSMovementDirection MovementDirection = EALSMovementDirection::Forward;
+
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
 	float ZoomAmount = 0.0f;
 
@@ -134,6 +138,44 @@ struct FALSAnimCharacterInformation
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
 	EALSViewMode ViewMode = EALSViewMode::ThirdPerson;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	FVector CapsuleLocation;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	FRotator LastUpdateRotation;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	float MaxAcceleration = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	float MaxBrakingDeceleration = 0.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	bool bIsMovingOnGround = false;
+
+	/** Time left until the predicted landing, negative while not falling or without a prediction */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	float TimeToLand = -1.0f;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	FVector LandImpactLocation;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	bool bLocallyControlledPlayer = false;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	bool bAutonomousProxy = false;
+
+	/** Features of the quality tier of the character */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	bool bDynamicTransitions = true;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	bool bFootIK = true;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	bool bFullFootIK = true;
 };
 
 
@@ -493,4 +535,8 @@ struct FALSAnimConfiguration
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	float IK_TraceDistanceBelowFoot = 45.0f;
+
+	/** Time to blend from the pose of the anim sharing leader back to the own pose */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float SharedPoseBlendOutTime = 0.3f;
 };
@@ -0,0 +1,70 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class USkeletalMesh;
+class USkeletalMeshComponent;
+
+/**
+ * Bones and sockets queried by native ALS code
+ */
+enum class EALSBoneSocket : uint8
+{
+	Root,
+	Pelvis,
+	Head,
+	FP_Camera,
+	TP_CameraTrace_L,
+	TP_CameraTrace_R,
+	IK_Foot_L,
+	IK_Foot_R,
+	VB_Foot_Target_L,
+	VB_Foot_Target_R,
+	MAX
+};
+
+/**
+ * Maps ALS bones and sockets of a skeletal mesh component to bone indices once, and reads their transforms
+ * directly from the component space transforms. Rebuilt when the component's skeletal mesh changes.
+ */
+class ALSV4_CPP_API FALSBoneCache
+{
+public:
+	FALSBoneCache();
+
+	static const FName& GetSocketName(EALSBoneSocket Socket);
+
+	FTransform GetSocketTransform(const USkeletalMeshComponent* Mesh, EALSBoneSocket Socket,
+	                              ERelativeTransformSpace TransformSpace = RTS_World) const;
+
+	FVector GetSocketLocation(const USkeletalMeshComponent* Mesh, EALSBoneSocket Socket) const
+	{
+		return GetSocketTransform(Mesh, Socket).GetLocation();
+	}
+
+	FRotator GetSocketRotation(const USkeletalMeshComponent* Mesh, EALSBoneSocket Socket) const
+	{
+		return GetSocketTransform(Mesh, Socket).Rotator();
+	}
+
+private:
+	void Rebuild(const USkeletalMeshComponent* Mesh) const;
+
+	mutable TWeakObjectPtr<const USkeletalMesh> CachedSkeletalMesh;
+
+	mutable bool bBuilt = false;
+
+	mutable int32 BoneIndices[static_cast<uint8>(EALSBoneSocket::MAX)];
+
+	/** Transform of the socket relative to its bone, identity for bones */
+	mutable FTransform SocketLocalTransforms[static_cast<uint8>(EALSBoneSocket::MAX)];
+};
@@ -145,3 +145,12 @@ enum class EALSMovementDirection : uint8
 	Left,
 	Backward
 };
+
+UENUM(BlueprintType)
+enum class EALSQualityTier : uint8
+{
+	High,
+	Medium,
+	Low,
+	Minimal
+};
@@ -85,6 +85,39 @@ struct FALSCameraStateSettings
 	FALSCameraGaitSettings Aiming;
 };
 
+/** Camera behavior curve values, read once per camera update or evaluated from a camera behavior data asset */
+USTRUCT(BlueprintType)
+struct FALSCameraBehaviorParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float RotationLagSpeed = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FVector PivotLagSpeed = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FVector PivotOffset = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FVector CameraOffset = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float OverrideDebug = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float WeightFirstPerson = 0.0f;
+
+	/** Param driven by the camera behavior anim graph curve of that name, nullptr for other names */
+	float* FindByCurveName(FName CurveName);
+
+	const float* FindByCurveName(FName CurveName) const
+	{
+		return const_cast<FALSCameraBehaviorParams*>(this)->FindByCurveName(CurveName);
+	}
+};
+
 USTRUCT(BlueprintType)
 struct FALSMantleAsset
 {
@@ -223,6 +256,50 @@ struct FALSMovementStateSettings : public FTableRowBase
 	FALSMovementStanceSettings Aiming;
 };
 
+/**
+ * Movement settings of a movement model flattened into a table, indexed by rotation mode and stance.
+ * Built once when the movement model is set, so looking up the target settings doesn't walk the row.
+ */
+struct FALSMovementSettingsTable
+{
+	static constexpr int32 NumRotationModes = 3;
+
+	static constexpr int32 NumStances = 2;
+
+	void Build(const FALSMovementStateSettings& MovementModel)
+	{
+		const FALSMovementStanceSettings* RotationModeSettings[NumRotationModes] = {
+			&MovementModel.VelocityDirection,
+			&MovementModel.LookingDirection,
+			&MovementModel.Aiming
+		};
+
+		for (int32 RotationModeIndex = 0; RotationModeIndex < NumRotationModes; ++RotationModeIndex)
+		{
+			Settings[RotationModeIndex][static_cast<uint8>(EALSStance::Standing)] =
+				RotationModeSettings[RotationModeIndex]->Standing;
+			Settings[RotationModeIndex][static_cast<uint8>(EALSStance::Crouching)] =
+				RotationModeSettings[RotationModeIndex]->Crouching;
+		}
+	}
+
+	const FALSMovementSettings& Get(EALSRotationMode RotationMode, EALSStance Stance) const
+	{
+		const uint8 RotationModeIndex = static_cast<uint8>(RotationMode);
+		const uint8 StanceIndex = static_cast<uint8>(Stance);
+		if (RotationModeIndex >= NumRotationModes || StanceIndex >= NumStances)
+		{
+			// Default to velocity dir standing
+			return Settings[static_cast<uint8>(EALSRotationMode::VelocityDirection)][static_cast<uint8>(
+				EALSStance::Standing)];
+		}
+		return Settings[RotationModeIndex][StanceIndex];
+	}
+
+private:
+	FALSMovementSettings Settings[NumRotationModes][NumStances];
+};
+
 USTRUCT(BlueprintType)
 struct FALSRotateInPlaceAsset
 {
@@ -0,0 +1,107 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UCurveBase;
+class UCurveFloat;
+class UCurveVector;
+
+/**
+ * Curve asset sampled at a fixed interval and evaluated with linear interpolation.
+ * Samples of each channel are stored contiguously, one channel after another.
+ */
+struct ALSV4_CPP_API FALSCurveTable
+{
+	float MinTime = 0.0f;
+
+	float InvSampleInterval = 0.0f;
+
+	int32 NumSamples = 0;
+
+	int32 NumChannels = 0;
+
+	/** Largest difference to the source curve the table is allowed to have */
+	float MaxError = 0.0f;
+
+	TArray<float> Samples;
+
+	float GetFloatValue(float Time) const
+	{
+		int32 Index;
+		const float Alpha = GetSamplePosition(Time, Index);
+		return GetChannelValue(0, Index, Alpha);
+	}
+
+	FVector GetVectorValue(float Time) const
+	{
+		int32 Index;
+		const float Alpha = GetSamplePosition(Time, Index);
+		return FVector(GetChannelValue(0, Index, Alpha), GetChannelValue(1, Index, Alpha),
+		               GetChannelValue(2, Index, Alpha));
+	}
+
+private:
+	float GetSamplePosition(float Time, int32& OutIndex) const
+	{
+		const float Position = FMath::Clamp((Time - MinTime) * InvSampleInterval, 0.0f,
+		                                    static_cast<float>(NumSamples - 1));
+		OutIndex = FMath::Min(FMath::TruncToInt(Position), NumSamples - 2);
+		return Position - OutIndex;
+	}
+
+	float GetChannelValue(int32 Channel, int32 Index, float Alpha) const
+	{
+		const float* ChannelSamples = Samples.GetData() + Channel * NumSamples + Index;
+		return FMath::Lerp(ChannelSamples[0], ChannelSamples[1], Alpha);
+	}
+};
+
+typedef TSharedPtr<const FALSCurveTable, ESPMode::ThreadSafe> FALSCurveTablePtr;
+
+/**
+ * Bakes curve assets into tables once and shares the tables between all users of the curve.
+ * Only float and vector curves with constant extrapolation are baked, and only if the table stays within the
+ * error bound (ALS.CurveTables.MaxError) at the maximum resolution. Other curves are evaluated directly.
+ */
+class ALSV4_CPP_API FALSCurveTableCache
+{
+public:
+	/** Table of the curve, baked on first use. Null if the curve can't be baked. */
+	static FALSCurveTablePtr FindOrBake(const UCurveBase* Curve);
+
+	/** Drops all baked tables, tables in use stay valid until released */
+	static void Flush();
+
+	/** Incremented whenever baked tables are dropped, handles rebind when it changes */
+	static uint32 GetGeneration();
+};
+
+/**
+ * Evaluates a curve asset through its baked table. Binds to the curve passed in, and rebinds when a different
+ * curve is passed or the cache is flushed. One handle per curve property, not thread safe.
+ */
+class ALSV4_CPP_API FALSCurveTableHandle
+{
+public:
+	float GetFloatValue(const UCurveFloat* Curve, float Time) const;
+
+	FVector GetVectorValue(const UCurveVector* Curve, float Time) const;
+
+private:
+	void Bind(const UCurveBase* Curve) const;
+
+	mutable TWeakObjectPtr<const UCurveBase> BoundCurve;
+
+	mutable uint32 BoundGeneration = 0;
+
+	mutable FALSCurveTablePtr Table;
+};
@@ -0,0 +1,33 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "ALSDynamicMontagePool.generated.h"
+
+class UAnimMontage;
+class UAnimSequenceBase;
+
+/**
+ * Dynamic montages built once per animation, slot and blend times and reused on every play, instead of building
+ * a new montage object each time an animation is played as a dynamic montage
+ */
+USTRUCT()
+struct ALSV4_CPP_API FALSDynamicMontagePool
+{
+	GENERATED_BODY()
+
+	/** Montage playing the animation once in the slot with the given blend times, built on first use */
+	UAnimMontage* FindOrCreate(UAnimSequenceBase* Animation, FName SlotName, float BlendInTime, float BlendOutTime);
+
+private:
+	UPROPERTY(Transient)
+	TArray<UAnimMontage*> Montages;
+};
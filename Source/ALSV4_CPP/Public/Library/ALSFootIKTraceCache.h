@@ -0,0 +1,44 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class UPrimitiveComponent;
+
+/**
+ * Last walkable hit of a foot IK trace. Reused instead of tracing again while the foot stays close to the floor
+ * location it was traced from and the hit component does not move.
+ */
+struct ALSV4_CPP_API FALSFootIKTraceCache
+{
+	/** Floor location the cached trace was issued from */
+	FVector FloorLocation = FVector::ZeroVector;
+
+	FVector ImpactPoint = FVector::ZeroVector;
+
+	FVector ImpactNormal = FVector::UpVector;
+
+	TWeakObjectPtr<const UPrimitiveComponent> Component;
+
+	/** Transform of the hit component when the trace was issued */
+	FTransform ComponentTransform = FTransform::Identity;
+
+	bool bValid = false;
+
+	/** True if the cached hit can be used for a foot at the given floor location */
+	bool CanReuse(const FVector& NewFloorLocation) const;
+
+	/** Caches a walkable hit, or clears the cache if the hit is not walkable */
+	void Store(const FHitResult& HitResult, bool bWalkable, const FVector& TracedFloorLocation);
+
+	void Invalidate() { bValid = false; }
+};
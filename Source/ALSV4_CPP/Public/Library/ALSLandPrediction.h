@@ -0,0 +1,66 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class ACharacter;
+class UPrimitiveComponent;
+struct FCollisionQueryParams;
+
+/**
+ * Ballistic prediction of where and when a falling character lands. The arc is swept once when the character
+ * leaves the ground and again only if the character no longer follows it, the time to land counts down in between.
+ */
+struct ALSV4_CPP_API FALSLandPrediction
+{
+	/** World time the prediction was made at */
+	float StartTime = 0.0f;
+
+	FVector StartLocation = FVector::ZeroVector;
+
+	FVector StartVelocity = FVector::ZeroVector;
+
+	float GravityZ = 0.0f;
+
+	/** Seconds after the start time the arc hits a surface, or the length of the swept arc if it hits nothing */
+	float Duration = 0.0f;
+
+	/** Capsule location at the impact */
+	FVector ImpactLocation = FVector::ZeroVector;
+
+	FVector ImpactNormal = FVector::UpVector;
+
+	TWeakObjectPtr<const UPrimitiveComponent> Component;
+
+	/** Transform of the hit component when the arc was swept */
+	FTransform ComponentTransform = FTransform::Identity;
+
+	bool bHit = false;
+
+	bool bWalkable = false;
+
+	bool bValid = false;
+
+	/** Sweeps the capsule of the character along its current ballistic arc */
+	void Predict(const ACharacter& Character, const FCollisionQueryParams& QueryParams, float Time);
+
+	/** True if the character left the predicted arc, the arc ran out or the surface it lands on moved */
+	bool IsInvalidated(const ACharacter& Character, float Time) const;
+
+	/** Seconds until the character lands on a walkable surface, or a negative value if no landing is predicted */
+	float GetTimeToLand(float Time) const;
+
+	FVector GetLocationAt(float Time) const;
+
+	FVector GetVelocityAt(float Time) const;
+
+	void Invalidate() { bValid = false; }
+};
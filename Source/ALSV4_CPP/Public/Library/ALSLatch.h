@@ -0,0 +1,44 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Short delay stored in its owner and polled during the owner's update, used instead of a world timer.
+ * Behaves like a timer that doesn't loop: setting it again restarts the delay, a delay of zero or less clears it.
+ */
+struct FALSLatch
+{
+	void Set(float Time, float Delay)
+	{
+		Deadline = Time + Delay;
+		bActive = Delay > 0.0f;
+	}
+
+	void Clear() { bActive = false; }
+
+	bool IsActive() const { return bActive; }
+
+	/** True once the delay has passed, the latch is cleared when it fires */
+	bool Poll(float Time)
+	{
+		if (bActive && Time >= Deadline)
+		{
+			bActive = false;
+			return true;
+		}
+		return false;
+	}
+
+private:
+	float Deadline = 0.0f;
+
+	bool bActive = false;
+};
@@ -0,0 +1,80 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Library/ALSAnimationStructLibrary.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
+
+/**
+ * Character values the gait selection is based on
+ */
+struct FALSGaitState
+{
+	EALSStance Stance = EALSStance::Standing;
+
+	EALSRotationMode RotationMode = EALSRotationMode::LookingDirection;
+
+	EALSGait DesiredGait = EALSGait::Running;
+
+	bool bHasMovementInput = false;
+
+	float MovementInputAmount = 0.0f;
+
+	/** Current acceleration of the character, its direction is the movement input direction */
+	FVector MovementInput = FVector::ZeroVector;
+
+	FRotator AimingRotation = FRotator::ZeroRotator;
+
+	float Speed = 0.0f;
+};
+
+/**
+ * Locomotion logic of ALS characters and anim instances, without access to any engine object.
+ * Takes value types in and returns value types, characters and anim instances gather the inputs and apply the results.
+ */
+struct ALSV4_CPP_API FALSLocomotionCore
+{
+	/** Gait */
+
+	static bool CanSprint(const FALSGaitState& State);
+
+	static EALSGait GetAllowedGait(const FALSGaitState& State);
+
+	static EALSGait GetActualGait(const FALSGaitState& State, const FALSMovementSettings& Settings,
+	                              EALSGait AllowedGait);
+
+	static float GetMappedSpeed(float Speed, const FALSMovementSettings& Settings);
+
+	/** Rotation */
+
+	/**
+	 * Interpolates the target rotation towards Target at a constant rate, and the actor rotation towards the target
+	 * rotation. Returns the new actor rotation.
+	 */
+	static FRotator SmoothRotation(const FRotator& ActorRotation, FRotator& InOutTargetRotation,
+	                               const FRotator& Target, float TargetInterpSpeed, float ActorInterpSpeed,
+	                               float DeltaTime);
+
+	/** Animation */
+
+	static FALSVelocityBlend CalculateVelocityBlend(const FVector& Velocity, const FRotator& ActorRotation);
+
+	/** Blends the stride curve values by the W_Gait and BasePose_CLF weights */
+	static float CalculateStrideBlend(float WalkStride, float RunStride, float CrouchStride, float GaitWeight,
+	                                  float CrouchWeight);
+
+	static void RotateInPlaceCheck(float AimingAngle, float AimYawRate, const FALSAnimRotateInPlace& Settings,
+	                               FALSAnimGraphGrounded& Grounded);
+
+	/** Updates the turn delay, returns true when the character should turn in place */
+	static bool TurnInPlaceCheck(float AimingAngle, float AimYawRate, float DeltaTime,
+	                             FALSAnimTurnInPlace& TurnInPlaceValues);
+};
@@ -0,0 +1,88 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Library/ALSLocomotionCore.h"
+
+/**
+ * State of a character in the headless locomotion simulation
+ */
+struct FALSSimulatedCharacter
+{
+	FVector Location = FVector::ZeroVector;
+
+	FVector Velocity = FVector::ZeroVector;
+
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	FRotator TargetRotation = FRotator::ZeroRotator;
+
+	FALSGaitState GaitState;
+
+	EALSGait Gait = EALSGait::Walking;
+
+	FALSVelocityBlend VelocityBlend;
+
+	/** Time until the simulated player picks a new input */
+	float InputChangeTime = 0.0f;
+};
+
+/**
+ * Settings of the headless locomotion simulation
+ */
+struct FALSLocomotionSimulationSettings
+{
+	/** Default ALS movement speeds, without curves */
+	FALSLocomotionSimulationSettings();
+
+	FALSMovementStanceSettings MovementSettings;
+
+	float Acceleration = 1500.0f;
+
+	float Deceleration = 2000.0f;
+
+	float RotationRate = 10.0f;
+
+	/** Average time between input changes of the simulated players */
+	float InputChangeInterval = 2.0f;
+
+	/** Chance of the simulated players to crouch on an input change */
+	float CrouchChance = 0.25f;
+};
+
+/**
+ * Runs the locomotion core on simulated characters at a fixed time step, without a world or any engine object.
+ * Characters are driven by random, seeded input and move with simplified kinematics instead of the character
+ * movement component, so the locomotion logic can be run and profiled faster than real time.
+ */
+class ALSV4_CPP_API FALSLocomotionSimulation
+{
+public:
+	explicit FALSLocomotionSimulation(const FALSLocomotionSimulationSettings& InSettings, int32 Seed = 0);
+
+	void AddCharacters(int32 Num);
+
+	/** Advances all characters by one fixed step */
+	void Step(float DeltaTime);
+
+	/** Advances all characters by Duration, in steps of StepTime */
+	void Run(float Duration, float StepTime = 1.0f / 60.0f);
+
+	const TArray<FALSSimulatedCharacter>& GetCharacters() const { return Characters; }
+
+private:
+	void UpdateInput(FALSSimulatedCharacter& Character, float DeltaTime);
+
+	FALSLocomotionSimulationSettings Settings;
+
+	FRandomStream RandomStream;
+
+	TArray<FALSSimulatedCharacter> Characters;
+};
@@ -60,4 +60,31 @@ public:
 	static EALSMovementDirection CalculateQuadrant(EALSMovementDirection Current, float FRThreshold, float FLThreshold,
 	                                               float BRThreshold,
 	                                               float BLThreshold, float Buffer, float Angle);
+
+	/**
+	 * Interpolates the location to its target on the axes of the yaw of the rotation, with a separate speed
+	 * for each axis
+	 */
+	static FVector CalculateAxisIndependentLag(FVector CurrentLocation, FVector TargetLocation, FRotator Rotation,
+	                                           FVector LagSpeeds, float DeltaTime);
+
+	/** Batch versions of the functions above, processing four values per SIMD operation */
+
+	/** Same result as CalculateQuadrant for each angle, whatever the current direction is */
+	static void CalculateQuadrants(TArrayView<const float> Angles, float FRThreshold, float FLThreshold,
+	                               float BRThreshold, float BLThreshold, float Buffer,
+	                               TArrayView<EALSMovementDirection> OutDirections);
+
+	/** Same result as FixDiagonalGamepadValues for each pair of values, done in place */
+	static void FixDiagonalGamepadValues(TArrayView<float> Y, TArrayView<float> X);
+
+	/** Same result as CalculateAxisIndependentLag for each location */
+	static void CalculateAxisIndependentLag(TArrayView<const FVector> CurrentLocations,
+	                                        TArrayView<const FVector> TargetLocations,
+	                                        TArrayView<const FRotator> Rotations, TArrayView<const FVector> LagSpeeds,
+	                                        float DeltaTime, TArrayView<FVector> OutLocations);
+
+	/** Same result as UKismetMathLibrary::TLerp with quaternion interpolation for each pair of transforms */
+	static void LerpTransforms(TArrayView<const FTransform> A, TArrayView<const FTransform> B,
+	                           TArrayView<const float> Alphas, TArrayView<FTransform> OutTransforms);
 };
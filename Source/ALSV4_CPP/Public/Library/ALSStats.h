@@ -0,0 +1,42 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Benchmark/ALSBenchmarkTimers.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("ALS"), STATGROUP_ALS, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces"), STAT_ALS_Traces, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPCs"), STAT_ALS_RPCs, STATGROUP_ALS, ALSV4_CPP_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ALSV4_CPP_API, ALS);
+
+/** Times a cycle stat and the CSV timing stat of the same name, e.g. ALS_SCOPE_CYCLE_COUNTER(MantleCheck) */
+#define ALS_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_ALS_##Name); \
+	CSV_SCOPED_TIMING_STAT(ALS, Name)
+
+/** Counts a scene query for the current frame, adds its time to the benchmark and marks it in Unreal Insights */
+#define ALS_SCOPE_TRACE() \
+	ALS_BENCHMARK_SCOPE(Traces); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(ALS_SceneQuery); \
+	INC_DWORD_STAT(STAT_ALS_Traces); \
+	CSV_CUSTOM_STAT(ALS, Traces, 1, ECsvCustomStatOp::Accumulate)
+
+/** Counts an RPC sent for the current frame */
+#define ALS_COUNT_RPC() \
+	do \
+	{ \
+		INC_DWORD_STAT(STAT_ALS_RPCs); \
+		CSV_CUSTOM_STAT(ALS, RPCs, 1, ECsvCustomStatOp::Accumulate); \
+	} while (0)
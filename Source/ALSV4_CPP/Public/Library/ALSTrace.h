@@ -0,0 +1,91 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2020 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+
+class AActor;
+
+#define ALS_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+/** States whose transitions are recorded on the ALS trace channel */
+enum class EALSTraceState : uint8
+{
+	MovementState,
+	Gait,
+	RotationMode,
+	ViewMode,
+	OverlayState
+};
+
+/** Outcome of a mantle attempt */
+enum class EALSTraceMantleResult : uint8
+{
+	Started,
+	NoWall,
+	MovingSurface,
+	NoWalkableLedge,
+	NoRoom
+};
+
+#if ALS_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_EXTERN(ALSChannel, ALSV4_CPP_API);
+
+/**
+ * Writes ALS events to Unreal Insights. Enable with -trace=ALS, or -trace=default,ALS to see them next to the CPU
+ * timings. Every event carries the unique id and net role of the character, and the cycle it happened on.
+ */
+class ALSV4_CPP_API FALSTrace
+{
+public:
+	static void OutputStateChange(const AActor* Character, EALSTraceState State, uint8 PrevValue, uint8 NewValue);
+
+	static void OutputMantle(const AActor* Character, EALSTraceMantleResult Result);
+
+	static void OutputRagdoll(const AActor* Character, bool bStart);
+};
+
+#define ALS_TRACE_STATE_CHANGE(Character, State, PrevValue, NewValue) \
+	do \
+	{ \
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(ALSChannel)) \
+		{ \
+			FALSTrace::OutputStateChange(Character, EALSTraceState::State, static_cast<uint8>(PrevValue), \
+			                             static_cast<uint8>(NewValue)); \
+		} \
+	} while (0)
+
+#define ALS_TRACE_MANTLE(Character, Result) \
+	do \
+	{ \
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(ALSChannel)) \
+		{ \
+			FALSTrace::OutputMantle(Character, EALSTraceMantleResult::Result); \
+		} \
+	} while (0)
+
+#define ALS_TRACE_RAGDOLL(Character, bStart) \
+	do \
+	{ \
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(ALSChannel)) \
+		{ \
+			FALSTrace::OutputRagdoll(Character, bStart); \
+		} \
+	} while (0)
+
+#else
+
+#define ALS_TRACE_STATE_CHANGE(Character, State, PrevValue, NewValue) do {} while (0)
+#define ALS_TRACE_MANTLE(Character, Result) do {} while (0)
+#define ALS_TRACE_RAGDOLL(Character, bStart) do {} while (0)
+
+#endif